@@ -35,7 +35,8 @@ public class FMODExtensions : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"Slate",
-				"SlateCore"
+				"SlateCore",
+				"SignificanceManager"
 			}
 			);
 		
@@ -1,32 +1,30 @@
 // Copyleft: All rights reversed
 
 #include "Public/FMOD/AnimNotifyState_FModPlayEvent.h"
-#include "FMODBlueprintStatics.h"
+#include "Public/FMOD/FModEventPoolSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+
+UAnimNotifyState_FModPlayEvent::UAnimNotifyState_FModPlayEvent()
+{
+	bFollow = false;
+	MaxAudibleDistance = 0.f;
+	MinSignificance = 0.f;
+}
 
 void UAnimNotifyState_FModPlayEvent::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation)
 {
-	if (UFMODAudioComponent* AudioComponent = MeshToComponentMap.FindRef(MeshComp))
+	// Notify object is shared by every mesh playing the animation, so voices are tracked by the pool per mesh
+	if (UFModEventPoolSubsystem* EventPool = UWorld::GetSubsystem<UFModEventPoolSubsystem>(MeshComp->GetWorld()))
 	{
-		AudioComponent->Stop();
-		MeshToComponentMap.Remove(MeshComp);
-	}
-	
-	if (MeshToEventInstanceMap.Contains(MeshComp)) {
-		UFMODBlueprintStatics::EventInstanceStop(MeshToEventInstanceMap.FindRef(MeshComp));
-		MeshToEventInstanceMap.Remove(MeshComp);
+		EventPool->StopEvent(this, MeshComp);
 	}
 }
 
 void UAnimNotifyState_FModPlayEvent::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
                                                  float TotalDuration, const FAnimNotifyEventReference& EventReference)
 {
-	if (bFollow)
-	{
-		UFMODAudioComponent* AudioComponent = UFMODBlueprintStatics::PlayEventAttached(Event, MeshComp, AttachName, FVector::ZeroVector, EAttachLocation::KeepRelativeOffset, false, true, true);
-		MeshToComponentMap.Add(MeshComp, AudioComponent);
-	} else
+	if (UFModEventPoolSubsystem* EventPool = UWorld::GetSubsystem<UFModEventPoolSubsystem>(MeshComp->GetWorld()))
 	{
-		const FFMODEventInstance EventInstance = UFMODBlueprintStatics::PlayEventAtLocation(GetWorld(), Event, MeshComp->GetComponentTransform(), true);
-		MeshToEventInstanceMap.Add(MeshComp, EventInstance);
+		EventPool->PlayEvent(this, Event, MeshComp, AttachName, bFollow, MaxAudibleDistance, MinSignificance);
 	}
 }
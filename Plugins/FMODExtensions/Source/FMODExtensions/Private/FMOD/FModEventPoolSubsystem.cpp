@@ -0,0 +1,232 @@
+// Copyleft: All rights reversed
+
+#include "Public/FMOD/FModEventPoolSubsystem.h"
+#include "FMODAudioComponent.h"
+#include "FMODEvent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SignificanceManager.h"
+
+
+void UFModEventPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UFModEventPoolSubsystem::HandleTicker), 0.25f);
+}
+
+void UFModEventPoolSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	while (ActiveVoices.Num() > 0)
+	{
+		ReleaseVoice(ActiveVoices.Num() - 1);
+	}
+
+	if (PoolOwner)
+	{
+		PoolOwner->Destroy();
+		PoolOwner = nullptr;
+	}
+	FreeComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFModEventPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Nobody listens on dedicated servers, notifies find no pool and do nothing
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UFModEventPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Animation previews play notifies too
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::EditorPreview;
+}
+
+bool UFModEventPoolSubsystem::PlayEvent(const UObject* Requester, UFMODEvent* Event, USkeletalMeshComponent* MeshComp,
+                                        const FName AttachName, const bool bFollow, const float MaxAudibleDistance,
+                                        const float MinSignificance)
+{
+	if (!Event || !MeshComp)
+	{
+		return false;
+	}
+
+	// Overlapping notify on the same mesh replaces the previous voice
+	StopEvent(Requester, MeshComp);
+
+	const FVector Location = MeshComp->GetSocketLocation(AttachName);
+	if (!IsAudible(Location, MaxAudibleDistance > 0.f ? MaxAudibleDistance : DefaultMaxAudibleDistance)
+		|| !IsSignificant(MeshComp->GetOwner(), MinSignificance))
+	{
+		return false;
+	}
+
+	const FObjectKey EventKey(Event);
+	int32 EventVoices = 0;
+	for (const FActiveVoice& Voice : ActiveVoices)
+	{
+		EventVoices += Voice.Event == EventKey ? 1 : 0;
+	}
+	if (EventVoices >= MaxVoicesPerEvent)
+	{
+		return false;
+	}
+
+	UFMODAudioComponent* Component = AcquireComponent();
+	if (!Component)
+	{
+		return false;
+	}
+
+	if (bFollow)
+	{
+		Component->AttachToComponent(MeshComp, FAttachmentTransformRules::SnapToTargetNotIncludingScale, AttachName);
+	}
+	else
+	{
+		Component->SetWorldLocationAndRotation(Location, MeshComp->GetComponentRotation());
+	}
+
+	Component->SetEvent(Event);
+	Component->Play();
+
+	FActiveVoice& Voice = ActiveVoices.AddDefaulted_GetRef();
+	Voice.Component = Component;
+	Voice.Event = EventKey;
+	Voice.Requester = FObjectKey(Requester);
+	Voice.Mesh = FObjectKey(MeshComp);
+	Voice.bFollow = bFollow;
+	Voice.FollowedMesh = MeshComp;
+	ActiveComponents.Add(Component);
+
+	return true;
+}
+
+void UFModEventPoolSubsystem::StopEvent(const UObject* Requester, const USkeletalMeshComponent* MeshComp)
+{
+	const FObjectKey RequesterKey(Requester);
+	const FObjectKey MeshKey(MeshComp);
+
+	for (int32 VoiceIndex = ActiveVoices.Num() - 1; VoiceIndex >= 0; --VoiceIndex)
+	{
+		if (ActiveVoices[VoiceIndex].Requester == RequesterKey && ActiveVoices[VoiceIndex].Mesh == MeshKey)
+		{
+			ReleaseVoice(VoiceIndex);
+		}
+	}
+}
+
+bool UFModEventPoolSubsystem::HandleTicker(float DeltaTime)
+{
+	// Return finished one-shots and voices of destroyed meshes to the pool
+	for (int32 VoiceIndex = ActiveVoices.Num() - 1; VoiceIndex >= 0; --VoiceIndex)
+	{
+		const FActiveVoice& Voice = ActiveVoices[VoiceIndex];
+		if (!IsValid(Voice.Component) || !Voice.Component->IsPlaying()
+			|| (Voice.bFollow && !Voice.FollowedMesh.IsValid()))
+		{
+			ReleaseVoice(VoiceIndex);
+		}
+	}
+	return true;
+}
+
+bool UFModEventPoolSubsystem::IsAudible(const FVector& Location, const float MaxDistance) const
+{
+	bool bHasListener = false;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ListenerLocation;
+			FVector FrontDir;
+			FVector RightDir;
+			PlayerController->GetAudioListenerPosition(ListenerLocation, FrontDir, RightDir);
+			if (FVector::DistSquared(ListenerLocation, Location) <= FMath::Square(MaxDistance))
+			{
+				return true;
+			}
+			bHasListener = true;
+		}
+	}
+
+	// No player to cull against, e.g. animation preview
+	return !bHasListener;
+}
+
+bool UFModEventPoolSubsystem::IsSignificant(const AActor* Actor, const float MinSignificance) const
+{
+	if (MinSignificance <= 0.f || !Actor)
+	{
+		return true;
+	}
+
+	const USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!SignificanceManager || !SignificanceManager->GetManagedObject(Actor))
+	{
+		return true;
+	}
+
+	return SignificanceManager->GetSignificance(Actor) >= MinSignificance;
+}
+
+UFMODAudioComponent* UFModEventPoolSubsystem::AcquireComponent()
+{
+	while (FreeComponents.Num() > 0)
+	{
+		UFMODAudioComponent* Component = FreeComponents.Pop(false);
+		if (IsValid(Component))
+		{
+			return Component;
+		}
+	}
+
+	if (!PoolOwner)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		PoolOwner = GetWorld()->SpawnActor<AActor>(SpawnParameters);
+		if (!PoolOwner)
+		{
+			return nullptr;
+		}
+	}
+
+	UFMODAudioComponent* Component = NewObject<UFMODAudioComponent>(PoolOwner);
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->RegisterComponent();
+	return Component;
+}
+
+void UFModEventPoolSubsystem::ReleaseVoice(const int32 VoiceIndex)
+{
+	UFMODAudioComponent* Component = ActiveVoices[VoiceIndex].Component;
+	ActiveVoices.RemoveAtSwap(VoiceIndex, 1, false);
+	ActiveComponents.RemoveSingleSwap(Component, false);
+
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	Component->Stop();
+	Component->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+
+	if (FreeComponents.Num() < MaxPooledComponents)
+	{
+		FreeComponents.Add(Component);
+	}
+	else
+	{
+		Component->DestroyComponent();
+	}
+}
@@ -11,7 +11,7 @@
 /**
  * UAnimNotifyState_FModPlayEvent
  *
- * Play FMod event and automatically stop it when AnimNotifyState ends
+ * Play FMod event and automatically stop it when AnimNotifyState ends. Playback goes through UFModEventPoolSubsystem
  */
 UCLASS()
 class FMODEXTENSIONS_API UAnimNotifyState_FModPlayEvent : public UAnimNotifyState
@@ -29,14 +29,18 @@ class FMODEXTENSIONS_API UAnimNotifyState_FModPlayEvent : public UAnimNotifyStat
 	/** Name of the socket or bone to attach sound to */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
 	FName AttachName;
-	
-	UPROPERTY(BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
-	TMap<USkeletalMeshComponent*, FFMODEventInstance> MeshToEventInstanceMap;
 
-	UPROPERTY(BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
-	TMap<USkeletalMeshComponent*, UFMODAudioComponent*> MeshToComponentMap;
+	/** Skip playback if mesh is further from every listener, 0 to use the pool default */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
+	float MaxAudibleDistance;
+
+	/** Skip playback if owner significance is lower, 0 to always play */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
+	float MinSignificance;
 
 public:
+	UAnimNotifyState_FModPlayEvent();
+
 	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation) override;
 	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
 	                         const FAnimNotifyEventReference& EventReference) override;
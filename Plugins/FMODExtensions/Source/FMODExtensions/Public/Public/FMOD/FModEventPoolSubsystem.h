@@ -0,0 +1,94 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FModEventPoolSubsystem.generated.h"
+
+class UFMODAudioComponent;
+class UFMODEvent;
+class USkeletalMeshComponent;
+
+
+/**
+ * UFModEventPoolSubsystem
+ *
+ * Plays FMod events for animation notifies through a pool of reused audio components. Playback is skipped for
+ * meshes beyond audible range of every local listener or below the requested significance, and the amount of
+ * concurrent voices per event is capped
+ */
+UCLASS(Config=Game)
+class FMODEXTENSIONS_API UFModEventPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Play event on mesh for requester (a notify), returns false if playback was culled. MaxAudibleDistance of 0 uses
+	 * the default one, MinSignificance is only checked for actors registered with the significance manager */
+	bool PlayEvent(const UObject* Requester, UFMODEvent* Event, USkeletalMeshComponent* MeshComp, FName AttachName,
+	               bool bFollow, float MaxAudibleDistance = 0.f, float MinSignificance = 0.f);
+
+	/** Stop event played by requester on mesh and return its component to the pool */
+	void StopEvent(const UObject* Requester, const USkeletalMeshComponent* MeshComp);
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	/** Concurrent voices of the same event, new playback is skipped above it */
+	UPROPERTY(Config)
+	int32 MaxVoicesPerEvent = 8;
+
+	/** Used if notify doesn't specify its own audible distance */
+	UPROPERTY(Config)
+	float DefaultMaxAudibleDistance = 5000.f;
+
+	/** Idle components kept for reuse, extra ones are destroyed */
+	UPROPERTY(Config)
+	int32 MaxPooledComponents = 64;
+
+private:
+	struct FActiveVoice
+	{
+		UFMODAudioComponent* Component = nullptr;
+		FObjectKey Event;
+		FObjectKey Requester;
+		FObjectKey Mesh;
+		TWeakObjectPtr<USkeletalMeshComponent> FollowedMesh;
+		bool bFollow = false;
+	};
+
+	bool HandleTicker(float DeltaTime);
+
+	bool IsAudible(const FVector& Location, float MaxDistance) const;
+	bool IsSignificant(const AActor* Actor, float MinSignificance) const;
+
+	UFMODAudioComponent* AcquireComponent();
+	void ReleaseVoice(int32 VoiceIndex);
+
+private:
+	/** Owner of pooled components */
+	UPROPERTY()
+	TObjectPtr<AActor> PoolOwner;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UFMODAudioComponent>> FreeComponents;
+
+	/** Components in ActiveVoices, referenced for garbage collection */
+	UPROPERTY()
+	TArray<TObjectPtr<UFMODAudioComponent>> ActiveComponents;
+
+	TArray<FActiveVoice> ActiveVoices;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -47,7 +47,8 @@ public class ECR : ModuleRules
 			"NetCore", 
 			"Networking", 
 			"Slate", 
-			"SlateCore"
+			"SlateCore",
+			"Sockets"
 		});
 	}
 }
\ No newline at end of file
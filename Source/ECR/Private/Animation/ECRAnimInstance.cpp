@@ -5,6 +5,7 @@
 #include "AbilitySystemGlobals.h"
 #include "Gameplay/Character/ECRCharacter.h"
 #include "Gameplay/Character/ECRCharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 
 
 UECRAnimInstance::UECRAnimInstance(const FObjectInitializer& ObjectInitializer)
@@ -19,6 +20,34 @@ void UECRAnimInstance::InitializeWithAbilitySystem(UAbilitySystemComponent* ASC)
 	GameplayTagPropertyMap.Initialize(this, ASC);
 }
 
+void UECRAnimInstance::SetAnimUpdateRate(const int32 UpdateRate)
+{
+	if (UpdateRate == AnimUpdateRate)
+	{
+		return;
+	}
+	AnimUpdateRate = UpdateRate;
+
+	USkeletalMeshComponent* MeshComp = GetSkelMeshComponent();
+
+	// The anim instance and its tag property map stay bound to the ability system, they just aren't evaluated
+	MeshComp->bNoSkeletonUpdate = UpdateRate == 0;
+
+	// Update rate optimizations skip and interpolate frames. Significance already accounts for distance and
+	// visibility, so every LOD and the not rendered state use the same rate
+	if (FAnimUpdateRateParameters* UpdateRateParams = MeshComp->AnimUpdateRateParams)
+	{
+		const int32 ClampedUpdateRate = FMath::Max(UpdateRate, 1);
+		UpdateRateParams->bShouldUseLodMap = true;
+		UpdateRateParams->LODToFrameSkipMap.Reset();
+		for (int32 LODIndex = 0; LODIndex < MeshComp->GetNumLODs(); ++LODIndex)
+		{
+			UpdateRateParams->LODToFrameSkipMap.Add(LODIndex, ClampedUpdateRate - 1);
+		}
+		UpdateRateParams->BaseNonRenderedUpdateRate = ClampedUpdateRate;
+	}
+}
+
 #if WITH_EDITOR
 EDataValidationResult UECRAnimInstance::IsDataValid(TArray<FText>& ValidationErrors)
 {
@@ -47,6 +76,13 @@ void UECRAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
+	NumNativeUpdates++;
+
+	if (AnimUpdateRate == 0)
+	{
+		return;
+	}
+
 	const AECRCharacter* Character = Cast<AECRCharacter>(GetOwningActor());
 	if (!Character)
 	{
@@ -2,6 +2,8 @@
 
 #include "GUI/Weapons/SHitMarkerConfirmationWidget.h"
 #include "Gameplay/Weapons/ECRWeaponStateComponent.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
 
 SHitMarkerConfirmationWidget::SHitMarkerConfirmationWidget()
 {
@@ -33,23 +35,14 @@ int32 SHitMarkerConfirmationWidget::OnPaint(const FPaintArgs& Args, const FGeome
 
 	if (bDrawMarkers)
 	{
-		// Check if we should use screen-space damage location hit notifies
-		TArray<FECRScreenSpaceHitLocation> LastWeaponDamageScreenLocations;
-		if (APlayerController* PC = MyContext.IsInitialized() ? MyContext.GetPlayerController() : nullptr)
-		{
-			if (UECRWeaponStateComponent* WeaponStateComponent = PC->FindComponentByClass<UECRWeaponStateComponent>())
-			{
-				WeaponStateComponent->GetLastWeaponDamageScreenLocations(/*out*/ LastWeaponDamageScreenLocations);
-			}
-		}
-
 		bool bDealtFriendlyDamage = false;
 		bool bDealtEnemyDamage = false;
 		bool bNonPenetrated = false;
 
-		if (LastWeaponDamageScreenLocations.Num() > 0)
+		// Screen-space damage location hit notifies, projected in Tick
+		if (ProjectedHitLocations.Num() > 0)
 		{
-			for (const FECRScreenSpaceHitLocation& Hit : LastWeaponDamageScreenLocations)
+			for (const FECRScreenSpaceHitLocation& Hit : ProjectedHitLocations)
 			{
 				const FSlateBrush* LocationMarkerImage = nullptr;
 
@@ -128,17 +121,73 @@ void SHitMarkerConfirmationWidget::Tick(const FGeometry& AllottedGeometry, const
                                         const float InDeltaTime)
 {
 	HitNotifyOpacity = 0.0f;
+	ProjectedHitLocations.Reset();
 
-	if (APlayerController* PC = MyContext.IsInitialized() ? MyContext.GetPlayerController() : nullptr)
+	if (UECRWeaponStateComponent* DamageMarkerComponent = GetWeaponStateComponent())
 	{
-		if (UECRWeaponStateComponent* DamageMarkerComponent = PC->FindComponentByClass<UECRWeaponStateComponent>())
+		const double TimeSinceLastHitNotification = DamageMarkerComponent->GetTimeSinceLastHitNotification();
+		if (TimeSinceLastHitNotification < HitNotifyDuration)
 		{
-			const double TimeSinceLastHitNotification = DamageMarkerComponent->GetTimeSinceLastHitNotification();
-			if (TimeSinceLastHitNotification < HitNotifyDuration)
-			{
-				HitNotifyOpacity = FMath::Clamp(1.0f - (float)(TimeSinceLastHitNotification / HitNotifyDuration), 0.0f,
-				                                1.0f);
-			}
+			HitNotifyOpacity = FMath::Clamp(1.0f - (float)(TimeSinceLastHitNotification / HitNotifyDuration), 0.0f,
+			                                1.0f);
+		}
+
+		if (HitNotifyOpacity > KINDA_SMALL_NUMBER)
+		{
+			ProjectHitLocations(DamageMarkerComponent->GetLastWeaponDamageLocations());
+		}
+	}
+}
+
+UECRWeaponStateComponent* SHitMarkerConfirmationWidget::GetWeaponStateComponent()
+{
+	APlayerController* PC = MyContext.IsInitialized() ? MyContext.GetPlayerController() : nullptr;
+	if (!PC)
+	{
+		return nullptr;
+	}
+
+	UECRWeaponStateComponent* WeaponStateComponent = CachedWeaponStateComponent.Get();
+	if (!WeaponStateComponent || WeaponStateComponent->GetOwner() != PC)
+	{
+		WeaponStateComponent = PC->FindComponentByClass<UECRWeaponStateComponent>();
+		CachedWeaponStateComponent = WeaponStateComponent;
+	}
+
+	return WeaponStateComponent;
+}
+
+void SHitMarkerConfirmationWidget::ProjectHitLocations(const TArray<FECRScreenSpaceHitLocation>& HitLocations)
+{
+	if (HitLocations.Num() == 0)
+	{
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = MyContext.GetLocalPlayer();
+	if (!LocalPlayer || !LocalPlayer->ViewportClient)
+	{
+		return;
+	}
+
+	// Same math as UGameplayStatics::ProjectWorldToScreen, but the view projection is only computed once
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, /*out*/ ProjectionData))
+	{
+		return;
+	}
+
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+	ProjectedHitLocations.Reserve(HitLocations.Num());
+	for (const FECRScreenSpaceHitLocation& Hit : HitLocations)
+	{
+		FVector2D ScreenLocation;
+		if (FSceneView::ProjectWorldToScreen(Hit.WorldLocation, ViewRect, ViewProjectionMatrix, ScreenLocation))
+		{
+			FECRScreenSpaceHitLocation& Projected = ProjectedHitLocations.Add_GetRef(Hit);
+			Projected.Location = ScreenLocation;
 		}
 	}
 }
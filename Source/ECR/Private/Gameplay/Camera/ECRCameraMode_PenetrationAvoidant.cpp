@@ -155,113 +155,69 @@ void UECRCameraMode_PenetrationAvoidant::PreventCameraPenetration(class AActor c
 	//	SphereParams.AddIgnoredActor(IgnoreActorForCameraPenetration);
 	//}
 
-	FCollisionShape SphereShape = FCollisionShape::MakeSphere(0.f);
-	UWorld* World = GetWorld();
-
-	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
+	// The main feeler is traced every frame, it's the one that actually keeps the camera out of the world
+	if (NumRaysToShoot > 0)
 	{
-		FECRPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
-		if (Feeler.FramesUntilNextTrace <= 0)
-		{
-			// calc ray target
-			FVector RayTarget;
-			{
-				FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
-				RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
-				RayTarget = SafeLoc + RotatedRay;
-			}
+		FECRPenetrationAvoidanceFeeler& MainFeeler = PenetrationAvoidanceFeelers[0];
+		MainFeeler.CachedBlockedPct = TraceFeeler(MainFeeler, ViewTarget, SafeLoc, BaseRay, BaseRayLocalUp,
+		                                          BaseRayLocalRight, SphereParams);
 
-			// cast for world and pawn hits separately.  this is so we can safely ignore the 
-			// camera's target pawn
-			SphereShape.Sphere.Radius = Feeler.Extent;
-			ECollisionChannel TraceChannel = ECC_Camera; //(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
-
-			// do multi-line check to make sure the hits we throw out aren't
-			// masking real hits behind (these are important rays).
+		// don't interpolate toward this one, snap to it
+		DistBlockedPctThisFrame = FMath::Min(MainFeeler.CachedBlockedPct, DistBlockedPctThisFrame);
+		HardBlockedPct = DistBlockedPctThisFrame;
+	}
 
-			// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
-			FHitResult Hit;
-			const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel,
-			                                              SphereShape, SphereParams);
-#if ENABLE_DRAW_DEBUG
-			if (World->TimeSince(LastDrawDebugTime) < 1.f)
-			{
-				DrawDebugSphere(World, SafeLoc, SphereShape.Sphere.Radius, 8, FColor::Red);
-				DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, SphereShape.Sphere.Radius, 8, FColor::Red);
-				DrawDebugLine(World, SafeLoc, bHit ? Hit.Location : RayTarget, FColor::Red);
-			}
-#endif // ENABLE_DRAW_DEBUG
+	// Predictive feelers share a per-frame trace budget and fall back to their cached results otherwise
+	const int32 NumPredictiveFeelers = NumRaysToShoot - 1;
+	if (NumPredictiveFeelers > 0)
+	{
+		const bool bReuseCachedResults = !bResetInterpolation && CanReuseCachedFeelers(SafeLoc, CameraLoc);
+		int32 TracesLeft = (MaxPredictiveFeelerTracesPerFrame > 0 && !bResetInterpolation)
+			                   ? MaxPredictiveFeelerTracesPerFrame
+			                   : NumPredictiveFeelers;
+		bool bHasPendingFeelers = false;
 
-			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+		if (NextPredictiveFeelerIndex < 1 || NextPredictiveFeelerIndex > NumPredictiveFeelers)
+		{
+			NextPredictiveFeelerIndex = 1;
+		}
 
-			const AActor* HitActor = Hit.GetActor();
+		const int32 FirstFeelerIndex = NextPredictiveFeelerIndex;
+		for (int32 Step = 0; Step < NumPredictiveFeelers; ++Step)
+		{
+			const int32 RayIdx = 1 + (FirstFeelerIndex - 1 + Step) % NumPredictiveFeelers;
+			FECRPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
 
-			if (bHit && HitActor)
+			if (!bReuseCachedResults)
 			{
-				bool bIgnoreHit = false;
-
-				if (HitActor->ActorHasTag(ECRCameraMode_PenetrationAvoidant_Statics::NAME_IgnoreCameraCollision))
+				if (Feeler.FramesUntilNextTrace > 0)
 				{
-					bIgnoreHit = true;
-					SphereParams.AddIgnoredActor(HitActor);
+					--Feeler.FramesUntilNextTrace;
 				}
-
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
+				else if (TracesLeft > 0)
 				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
-					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
-					}
-					else
-					{
-#if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-					}
+					--TracesLeft;
+					Feeler.CachedBlockedPct = TraceFeeler(Feeler, ViewTarget, SafeLoc, BaseRay, BaseRayLocalUp,
+					                                      BaseRayLocalRight, SphereParams);
+					NextPredictiveFeelerIndex = RayIdx % NumPredictiveFeelers + 1;
 				}
-
-				if (!bIgnoreHit)
+				else
 				{
-					float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
-					float NewBlockPct = Hit.Time;
-					NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
-
-					// Recompute blocked pct taking into account pushout distance.
-					NewBlockPct = ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).
-						Size();
-					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
-
-					// This feeler got a hit, so do another trace next frame
-					Feeler.FramesUntilNextTrace = 0;
-
-#if ENABLE_DRAW_DEBUG
-					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
+					bHasPendingFeelers = true;
 				}
 			}
 
-			if (RayIdx == 0)
-			{
-				// don't interpolate toward this one, snap to it
-				// assumes ray 0 is the center/main ray 
-				HardBlockedPct = DistBlockedPctThisFrame;
-			}
-			else
-			{
-				SoftBlockedPct = DistBlockedPctThisFrame;
-			}
+			DistBlockedPctThisFrame = FMath::Min(Feeler.CachedBlockedPct, DistBlockedPctThisFrame);
 		}
-		else
+
+		SoftBlockedPct = DistBlockedPctThisFrame;
+
+		if (!bReuseCachedResults)
 		{
-			--Feeler.FramesUntilNextTrace;
+			// Only start reusing results once every due feeler was traced near the current position
+			bHasCachedFeelerResults = !bHasPendingFeelers;
+			LastFeelerSafeLoc = SafeLoc;
+			LastFeelerCameraLoc = CameraLoc;
 		}
 	}
 
@@ -310,6 +266,109 @@ void UECRCameraMode_PenetrationAvoidant::PreventCameraPenetration(class AActor c
 	}
 }
 
+float UECRCameraMode_PenetrationAvoidant::TraceFeeler(FECRPenetrationAvoidanceFeeler& Feeler,
+                                                      class AActor const& ViewTarget, FVector const& SafeLoc,
+                                                      FVector const& BaseRay, FVector const& BaseRayLocalUp,
+                                                      FVector const& BaseRayLocalRight,
+                                                      FCollisionQueryParams& SphereParams)
+{
+	UWorld* World = GetWorld();
+	float BlockedPct = 1.f;
+
+	// calc ray target
+	FVector RayTarget;
+	{
+		FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
+		RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
+		RayTarget = SafeLoc + RotatedRay;
+	}
+
+	// cast for world and pawn hits separately.  this is so we can safely ignore the 
+	// camera's target pawn
+	const FCollisionShape SphereShape = FCollisionShape::MakeSphere(Feeler.Extent);
+	ECollisionChannel TraceChannel = ECC_Camera; //(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
+
+	// do multi-line check to make sure the hits we throw out aren't
+	// masking real hits behind (these are important rays).
+
+	// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
+	FHitResult Hit;
+	const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel,
+	                                              SphereShape, SphereParams);
+#if ENABLE_DRAW_DEBUG
+	if (World->TimeSince(LastDrawDebugTime) < 1.f)
+	{
+		DrawDebugSphere(World, SafeLoc, SphereShape.Sphere.Radius, 8, FColor::Red);
+		DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, SphereShape.Sphere.Radius, 8, FColor::Red);
+		DrawDebugLine(World, SafeLoc, bHit ? Hit.Location : RayTarget, FColor::Red);
+	}
+#endif // ENABLE_DRAW_DEBUG
+
+	Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+
+	const AActor* HitActor = Hit.GetActor();
+
+	if (bHit && HitActor)
+	{
+		bool bIgnoreHit = false;
+
+		if (HitActor->ActorHasTag(ECRCameraMode_PenetrationAvoidant_Statics::NAME_IgnoreCameraCollision))
+		{
+			bIgnoreHit = true;
+			SphereParams.AddIgnoredActor(HitActor);
+		}
+
+		// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+		if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
+		{
+			const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+			const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+			const FVector HitOffset = Hit.Location - ViewTargetLocation;
+			const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+			const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+			if (DotHitDirection > 0.0f)
+			{
+				bIgnoreHit = true;
+				// Ignore this CameraBlockingVolume on the remaining sweeps.
+				SphereParams.AddIgnoredActor(HitActor);
+			}
+			else
+			{
+#if ENABLE_DRAW_DEBUG
+				DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+			}
+		}
+
+		if (!bIgnoreHit)
+		{
+			// Recompute blocked pct taking into account pushout distance.
+			BlockedPct = ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).Size();
+
+			// This feeler got a hit, so do another trace next frame
+			Feeler.FramesUntilNextTrace = 0;
+
+#if ENABLE_DRAW_DEBUG
+			DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+		}
+	}
+
+	return BlockedPct;
+}
+
+bool UECRCameraMode_PenetrationAvoidant::CanReuseCachedFeelers(FVector const& SafeLoc, FVector const& CameraLoc) const
+{
+	if (!bHasCachedFeelerResults)
+	{
+		return false;
+	}
+
+	const float ReuseDistanceSquared = FMath::Square(FeelerCacheReuseDistance);
+	return FVector::DistSquared(SafeLoc, LastFeelerSafeLoc) <= ReuseDistanceSquared
+		&& FVector::DistSquared(CameraLoc, LastFeelerCameraLoc) <= ReuseDistanceSquared;
+}
+
 
 void UECRCameraMode_PenetrationAvoidant::DrawDebug(UCanvas* Canvas) const
 {
@@ -19,6 +19,7 @@
 #include "TimerManager.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "Gameplay/ECRGameState.h"
+#include "Gameplay/ECRGameMode.h"
 #include "Gameplay/Character/ECRPawnData.h"
 #include "Gameplay/GAS/ECRAbilitySet.h"
 #include "Gameplay/GAS/Attributes/ECRCharacterHealthSet.h"
@@ -106,6 +107,15 @@ AECRCharacter::AECRCharacter(const FObjectInitializer& ObjectInitializer)
 	OrientationToMovementOrientedRequirementAlpha = 0.0f;
 }
 
+void AECRCharacter::PreRegisterAllComponents()
+{
+	Super::PreRegisterAllComponents();
+
+	// Animation update rate follows significance, which is only applied to characters simulated on clients.
+	// Authoritative poses drive root motion and hit detection, so they are always fully updated
+	GetMesh()->bEnableUpdateRateOptimizations = !HasAuthority();
+}
+
 void AECRCharacter::PreInitializeComponents()
 {
 	Super::PreInitializeComponents();
@@ -125,12 +135,12 @@ void AECRCharacter::BeginPlay()
 
 	UWorld* World = GetWorld();
 
-	const bool bRegisterWithSignificanceManager = !IsNetMode(NM_DedicatedServer);
+	const bool bRegisterWithSignificanceManager = !HasAuthority();
 	if (bRegisterWithSignificanceManager)
 	{
 		if (UECRSignificanceManager* SignificanceManager = USignificanceManager::Get<UECRSignificanceManager>(World))
 		{
-			//@TODO: SignificanceManager->RegisterObject(this, (EFortSignificanceType)SignificanceType);
+			SignificanceManager->RegisterCharacter(this);
 		}
 	}
 
@@ -143,7 +153,7 @@ void AECRCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	UWorld* World = GetWorld();
 
-	const bool bRegisterWithSignificanceManager = !IsNetMode(NM_DedicatedServer);
+	const bool bRegisterWithSignificanceManager = !HasAuthority();
 	if (bRegisterWithSignificanceManager)
 	{
 		if (UECRSignificanceManager* SignificanceManager = USignificanceManager::Get<UECRSignificanceManager>(World))
@@ -153,6 +163,14 @@ void AECRCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	}
 }
 
+bool AECRCharacter::IsReplayRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation,
+                                        const float CullDistance) const
+{
+	// Server replays keep players at the full rate, not only while another player sees them
+	return AECRGameMode::IsCriticalForReplay(this)
+		|| Super::IsReplayRelevantFor(RealViewer, ViewTarget, SrcLocation, CullDistance);
+}
+
 void AECRCharacter::Reset()
 {
 	DisableMovementAndCollision();
@@ -213,12 +231,18 @@ void AECRCharacter::OnAbilitySystemInitialized()
 
 	HealthComponent->InitializeWithAbilitySystem(ECRASC);
 
+	UECRCharacterMovementComponent* ECRMoveComp = CastChecked<UECRCharacterMovementComponent>(GetCharacterMovement());
+	ECRMoveComp->InitializeWithAbilitySystem(ECRASC);
+
 	InitializeGameplayTags();
 }
 
 void AECRCharacter::OnAbilitySystemUninitialized()
 {
 	HealthComponent->UninitializeFromAbilitySystem();
+
+	UECRCharacterMovementComponent* ECRMoveComp = CastChecked<UECRCharacterMovementComponent>(GetCharacterMovement());
+	ECRMoveComp->UninitializeFromAbilitySystem();
 }
 
 void AECRCharacter::PossessedBy(AController* NewController)
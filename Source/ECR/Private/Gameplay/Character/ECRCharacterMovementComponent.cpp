@@ -4,19 +4,24 @@
 #include "GameFramework/Character.h"
 #include "CollisionQueryParams.h"
 #include "Components/CapsuleComponent.h"
-#include "AbilitySystemGlobals.h"
 #include "NativeGameplayTags.h"
 #include "AbilitySystemComponent.h"
 #include "WheeledVehiclePawn.h"
+#include "System/ECRServerStatsSubsystem.h"
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_MovementStopped, "Gameplay.MovementStopped");
 
 namespace ECRCharacter
 {
-	static float GroundTraceDistance = 100000.0f;
+	static float GroundTraceDistance = 5000.0f;
 	FAutoConsoleVariableRef CVar_GroundTraceDistance(
 		TEXT("ECRCharacter.GroundTraceDistance"), GroundTraceDistance,
-		TEXT("Distance to trace down when generating ground information."), ECVF_Cheat);
+		TEXT("Distance to trace down when generating ground information while not walking."), ECVF_Cheat);
+
+	static float GroundInfoTolerance = 1.0f;
+	FAutoConsoleVariableRef CVar_GroundInfoTolerance(
+		TEXT("ECRCharacter.GroundInfoTolerance"), GroundInfoTolerance,
+		TEXT("Horizontal movement allowed before cached ground information is traced again."), ECVF_Cheat);
 };
 
 
@@ -39,54 +44,133 @@ void UECRCharacterMovementComponent::InitializeComponent()
 	Super::InitializeComponent();
 }
 
+void UECRCharacterMovementComponent::ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData)
+{
+	ECR_SERVER_STAT_SCOPE(MovementServerMove);
+
+	Super::ServerMove_PerformMovement(MoveData);
+}
+
+void UECRCharacterMovementComponent::InitializeWithAbilitySystem(UAbilitySystemComponent* InASC)
+{
+	if (!InASC || InASC == MovementModifiersAbilitySystem.Get())
+	{
+		return;
+	}
+
+	UninitializeFromAbilitySystem();
+
+	MovementModifiersAbilitySystem = InASC;
+	MovementStoppedTagChangedHandle = InASC->RegisterGameplayTagEvent(
+		TAG_Gameplay_MovementStopped, EGameplayTagEventType::NewOrRemoved).AddUObject(
+		this, &ThisClass::HandleMovementStoppedTagChanged);
+	bMovementStopped = InASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped);
+}
+
+void UECRCharacterMovementComponent::UninitializeFromAbilitySystem()
+{
+	if (UAbilitySystemComponent* ASC = MovementModifiersAbilitySystem.Get())
+	{
+		ASC->UnregisterGameplayTagEvent(MovementStoppedTagChangedHandle, TAG_Gameplay_MovementStopped,
+		                                EGameplayTagEventType::NewOrRemoved);
+	}
+
+	MovementModifiersAbilitySystem.Reset();
+	MovementStoppedTagChangedHandle.Reset();
+	bMovementStopped = false;
+}
+
+void UECRCharacterMovementComponent::HandleMovementStoppedTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	bMovementStopped = NewCount > 0;
+}
+
 const FECRCharacterGroundInfo& UECRCharacterMovementComponent::GetGroundInfo()
 {
-	if (!CharacterOwner || (GFrameCounter == CachedGroundInfo.LastUpdateFrame))
+	if (!CharacterOwner)
 	{
 		return CachedGroundInfo;
 	}
 
+	// Movement already found the floor
 	if (MovementMode == MOVE_Walking)
 	{
 		CachedGroundInfo.GroundHitResult = CurrentFloor.HitResult;
 		CachedGroundInfo.GroundDistance = 0.0f;
+		CachedGroundInfo.LastUpdateFrame = GFrameCounter;
+		GroundInfoMovementMode = MOVE_None;
+		return CachedGroundInfo;
 	}
-	else
+
+	const UCapsuleComponent* CapsuleComp = CharacterOwner->GetCapsuleComponent();
+	check(CapsuleComp);
+
+	const float CapsuleHalfHeight = CapsuleComp->GetUnscaledCapsuleHalfHeight();
+	const FVector TraceStart(GetActorLocation());
+	const float TraceLength = ECRCharacter::GroundTraceDistance + CapsuleHalfHeight;
+
+	// Cached info stays valid until the character moves, a vertical move over the same ground only changes the
+	// distance to it. That covers jumping in place and the apex of jumps without tracing again
+	if (MovementMode == GroundInfoMovementMode)
 	{
-		const UCapsuleComponent* CapsuleComp = CharacterOwner->GetCapsuleComponent();
-		check(CapsuleComp);
-
-		const float CapsuleHalfHeight = CapsuleComp->GetUnscaledCapsuleHalfHeight();
-		const ECollisionChannel CollisionChannel = (UpdatedComponent
-			                                            ? UpdatedComponent->GetCollisionObjectType()
-			                                            : ECC_Pawn);
-		const FVector TraceStart(GetActorLocation());
-		const FVector TraceEnd(TraceStart.X, TraceStart.Y,
-		                       (TraceStart.Z - ECRCharacter::GroundTraceDistance - CapsuleHalfHeight));
-
-		FCollisionQueryParams QueryParams(
-			SCENE_QUERY_STAT(ECRCharacterMovementComponent_GetGroundInfo), false, CharacterOwner);
-		FCollisionResponseParams ResponseParam;
-		InitCollisionParams(QueryParams, ResponseParam);
-
-		FHitResult HitResult;
-		GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CollisionChannel, QueryParams,
-		                                     ResponseParam);
-
-		CachedGroundInfo.GroundHitResult = HitResult;
-		CachedGroundInfo.GroundDistance = ECRCharacter::GroundTraceDistance;
-
-		if (MovementMode == MOVE_NavWalking)
+		const FVector Delta = TraceStart - CachedGroundInfo.GroundHitResult.TraceStart;
+		if (FMath::Abs(Delta.X) <= ECRCharacter::GroundInfoTolerance && FMath::Abs(Delta.Y) <= ECRCharacter::GroundInfoTolerance)
 		{
-			CachedGroundInfo.GroundDistance = 0.0f;
-		}
-		else if (HitResult.bBlockingHit)
-		{
-			CachedGroundInfo.GroundDistance = FMath::Max((HitResult.Distance - CapsuleHalfHeight), 0.0f);
+			if (FMath::IsNearlyZero(Delta.Z))
+			{
+				return CachedGroundInfo;
+			}
+
+			FHitResult& HitResult = CachedGroundInfo.GroundHitResult;
+			const float HitDistance = HitResult.Distance + Delta.Z;
+			if (HitResult.bBlockingHit && MovementMode != MOVE_NavWalking && HitDistance >= 0.0f && HitDistance <= TraceLength)
+			{
+				HitResult.TraceStart = TraceStart;
+				HitResult.TraceEnd = FVector(TraceStart.X, TraceStart.Y, TraceStart.Z - TraceLength);
+				HitResult.Distance = HitDistance;
+				HitResult.Time = HitDistance / TraceLength;
+
+				CachedGroundInfo.GroundDistance = FMath::Max(HitDistance - CapsuleHalfHeight, 0.0f);
+				CachedGroundInfo.LastUpdateFrame = GFrameCounter;
+				return CachedGroundInfo;
+			}
 		}
 	}
 
+	ECR_SERVER_STAT_SCOPE(GroundInfoTrace);
+
+	const ECollisionChannel CollisionChannel = (UpdatedComponent
+		                                            ? UpdatedComponent->GetCollisionObjectType()
+		                                            : ECC_Pawn);
+	const FVector TraceEnd(TraceStart.X, TraceStart.Y, TraceStart.Z - TraceLength);
+
+	FCollisionQueryParams QueryParams(
+		SCENE_QUERY_STAT(ECRCharacterMovementComponent_GetGroundInfo), false, CharacterOwner);
+	FCollisionResponseParams ResponseParam;
+	InitCollisionParams(QueryParams, ResponseParam);
+
+	FHitResult HitResult;
+	GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CollisionChannel, QueryParams,
+	                                     ResponseParam);
+
+	// Keep the trace start of misses too, it's what cached info is compared against
+	HitResult.TraceStart = TraceStart;
+	HitResult.TraceEnd = TraceEnd;
+
+	CachedGroundInfo.GroundHitResult = HitResult;
+	CachedGroundInfo.GroundDistance = ECRCharacter::GroundTraceDistance;
+
+	if (MovementMode == MOVE_NavWalking)
+	{
+		CachedGroundInfo.GroundDistance = 0.0f;
+	}
+	else if (HitResult.bBlockingHit)
+	{
+		CachedGroundInfo.GroundDistance = FMath::Max((HitResult.Distance - CapsuleHalfHeight), 0.0f);
+	}
+
 	CachedGroundInfo.LastUpdateFrame = GFrameCounter;
+	GroundInfoMovementMode = MovementMode;
 
 	return CachedGroundInfo;
 }
@@ -94,12 +178,9 @@ const FECRCharacterGroundInfo& UECRCharacterMovementComponent::GetGroundInfo()
 
 FRotator UECRCharacterMovementComponent::GetDeltaRotation(float DeltaTime) const
 {
-	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()))
+	if (bMovementStopped)
 	{
-		if (ASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped))
-		{
-			return FRotator(0, 0, 0);
-		}
+		return FRotator(0, 0, 0);
 	}
 
 	return Super::GetDeltaRotation(DeltaTime);
@@ -107,12 +188,9 @@ FRotator UECRCharacterMovementComponent::GetDeltaRotation(float DeltaTime) const
 
 float UECRCharacterMovementComponent::GetMaxSpeed() const
 {
-	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()))
+	if (bMovementStopped)
 	{
-		if (ASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped))
-		{
-			return 0;
-		}
+		return 0;
 	}
 
 	return Super::GetMaxSpeed();
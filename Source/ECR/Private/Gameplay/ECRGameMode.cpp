@@ -7,7 +7,12 @@
 #include "GameFramework/PlayerState.h"
 #include "Gameplay/Character/ECRCharacter.h"
 #include "Gameplay/Character/ECRPawnExtensionComponent.h"
+#include "Gameplay/Replays/ECRReplaySubsystem.h"
+#include "System/ECRGameInstance.h"
 #include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
+#include "GameFramework/Info.h"
+#include "HAL/IConsoleManager.h"
 #include "UObject/ConstructorHelpers.h"
 
 AECRGameMode::AECRGameMode()
@@ -53,7 +58,14 @@ void AECRGameMode::HandleMatchHasStarted()
 
 	if (IsHandlingReplays() && GetGameInstance() != nullptr)
 	{
-		GetGameInstance()->StartRecordingReplay(GetWorld()->GetMapName(), GetWorld()->GetMapName());
+		if (bFilterReplayRecording)
+		{
+			StartReplayRecordingFilter();
+		}
+
+		// Through the replay subsystem so server recordings get the same checkpoint settings
+		UECRReplaySubsystem* ReplaySubsystem = GetGameInstance()->GetSubsystem<UECRReplaySubsystem>();
+		ReplaySubsystem->StartRecordingReplay(GetWorld()->GetMapName(), GetWorld()->GetMapName());
 	}
 }
 
@@ -68,6 +80,30 @@ FString AECRGameMode::InitNewPlayer(APlayerController* NewPlayerController, cons
 }
 
 
+void AECRGameMode::PostLogin(APlayerController* NewPlayer)
+{
+	Super::PostLogin(NewPlayer);
+	UpdateAdvertisedPlayerAmount();
+}
+
+
+void AECRGameMode::Logout(AController* Exiting)
+{
+	Super::Logout(Exiting);
+	UpdateAdvertisedPlayerAmount();
+}
+
+
+void AECRGameMode::UpdateAdvertisedPlayerAmount()
+{
+	if (UECRGameInstance* GameInstance = GetGameInstance<UECRGameInstance>())
+	{
+		// Human players only, bots aren't counted against session capacity
+		GameInstance->UpdateSessionCurrentPlayerAmount(GetNumPlayers());
+	}
+}
+
+
 bool AECRGameMode::ControllerCanRestart(AController* Controller)
 {
 	if (APlayerController* PC = Cast<APlayerController>(Controller))
@@ -87,4 +123,82 @@ bool AECRGameMode::ControllerCanRestart(AController* Controller)
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+void AECRGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ActorSpawnedForReplayHandle.IsValid())
+	{
+		GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedForReplayHandle);
+		ActorSpawnedForReplayHandle.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+EECRReplayImportance AECRGameMode::GetReplayImportance(const AActor* Actor) const
+{
+	for (const TSubclassOf<AActor>& ExcludedClass : ReplayExcludedActorClasses)
+	{
+		if (ExcludedClass && Actor->IsA(ExcludedClass))
+		{
+			return EECRReplayImportance::Excluded;
+		}
+	}
+
+	// Game state, player states and other match info, plus everything a player or bot is driving
+	if (Actor->IsA<AInfo>() || Actor->IsA<APawn>())
+	{
+		return EECRReplayImportance::Critical;
+	}
+
+	// Weapons, projectiles, pickups, doors, objectives...
+	return EECRReplayImportance::Gameplay;
+}
+
+bool AECRGameMode::IsCriticalForReplay(const AActor* Actor)
+{
+	const UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	const AECRGameMode* GameMode = World ? World->GetAuthGameMode<AECRGameMode>() : nullptr;
+	return GameMode && GameMode->bFilterReplayRecording
+		&& GameMode->GetReplayImportance(Actor) == EECRReplayImportance::Critical;
+}
+
+void AECRGameMode::StartReplayRecordingFilter()
+{
+	// Actors no player has relevant are recorded at a reduced rate, so gameplay actors away from the
+	// fighting cost little while the ones near combat are recorded at the full rate
+	if (IConsoleVariable* UseNetRelevancy = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.UseNetRelevancy")))
+	{
+		UseNetRelevancy->Set(1, ECVF_SetByCode);
+	}
+	if (IConsoleVariable* RecordHzWhenNotRelevant = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.RecordHzWhenNotRelevant")))
+	{
+		RecordHzWhenNotRelevant->Set(ReplayRecordHzWhenNotRelevant, ECVF_SetByCode);
+	}
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		ApplyReplayImportance(*It);
+	}
+
+	if (!ActorSpawnedForReplayHandle.IsValid())
+	{
+		ActorSpawnedForReplayHandle = GetWorld()->AddOnActorSpawnedHandler(
+			FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawnedForReplay));
+	}
+}
+
+void AECRGameMode::ApplyReplayImportance(AActor* Actor) const
+{
+	// Only ever opt out, actors that chose not to be recorded stay that way
+	if (Actor && Actor->GetIsReplicated() && GetReplayImportance(Actor) == EECRReplayImportance::Excluded)
+	{
+		Actor->bRelevantForNetworkReplays = false;
+	}
+}
+
+void AECRGameMode::HandleActorSpawnedForReplay(AActor* Actor)
+{
+	ApplyReplayImportance(Actor);
+}
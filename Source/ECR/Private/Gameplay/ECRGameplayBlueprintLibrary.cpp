@@ -9,14 +9,12 @@ double UECRGameplayBlueprintLibrary::CalculateDamageAttenuationForArmorPenetrati
 	// Make sure Toughness - ArmorPenetration >= 0 or ArmorPenetration <= Toughness
 	ArmorPenetration = FMath::Min(ArmorPenetration, Toughness);
 
-	// Main formula
-	double Attenuation = 1 - 2 * (1 / (1 + FMath::Exp(-0.015 * (Toughness - ArmorPenetration))) - 0.5);
-
 	// If Armor > ArmorPenetration, then no damage at all
 	if (ArmorPenetration < Armor)
 	{
-		Attenuation = 0.0f;
+		return 0.0f;
 	}
 
-	return Attenuation;
+	// Main formula
+	return 1 - 2 * (1 / (1 + FMath::Exp(-0.015 * (Toughness - ArmorPenetration))) - 0.5);
 }
@@ -23,14 +23,23 @@ FString FECRAppliedEquipmentEntry::GetDebugString() const
 
 void FECREquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	bool bRemovedUnknownInstance = false;
 	for (int32 Index : RemovedIndices)
 	{
 		const FECRAppliedEquipmentEntry& Entry = Entries[Index];
+		bRemovedUnknownInstance |= Entry.Instance == nullptr;
 		if (Entry.Instance != nullptr)
 		{
+			RemoveFromTypeIndex(Entry.Instance);
 			Entry.Instance->OnUnequipped();
 		}
 	}
+
+	// The index may still hold the instance the entry referenced before it was cleared
+	if (bRemovedUnknownInstance)
+	{
+		RebuildTypeIndex(RemovedIndices);
+	}
 }
 
 void FECREquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
@@ -40,6 +49,7 @@ void FECREquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 		const FECRAppliedEquipmentEntry& Entry = Entries[Index];
 		if (Entry.Instance != nullptr)
 		{
+			AddToTypeIndex(Entry.Instance);
 			Entry.Instance->OnEquipped();
 		}
 	}
@@ -47,11 +57,59 @@ void FECREquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 
 void FECREquipmentList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
-	// 	for (int32 Index : ChangedIndices)
-	// 	{
-	// 		const FGameplayTagStack& Stack = Stacks[Index];
-	// 		TagToCountMap[Stack.Tag] = Stack.StackCount;
-	// 	}
+	// The instance may not have been resolved yet when the entry was added, or may have been replaced, so the old
+	// one has to leave the index as well
+	RebuildTypeIndex(TArrayView<int32>());
+}
+
+const TArray<UECREquipmentInstance*>* FECREquipmentList::FindInstancesOfType(const UClass* InstanceType) const
+{
+	return InstancesByType.Find(InstanceType);
+}
+
+void FECREquipmentList::AddToTypeIndex(UECREquipmentInstance* Instance)
+{
+	for (const UClass* Class = Instance->GetClass(); Class != nullptr; Class = Class->GetSuperClass())
+	{
+		InstancesByType.FindOrAdd(Class).AddUnique(Instance);
+
+		if (Class == UECREquipmentInstance::StaticClass())
+		{
+			break;
+		}
+	}
+}
+
+void FECREquipmentList::RemoveFromTypeIndex(UECREquipmentInstance* Instance)
+{
+	for (const UClass* Class = Instance->GetClass(); Class != nullptr; Class = Class->GetSuperClass())
+	{
+		if (TArray<UECREquipmentInstance*>* Instances = InstancesByType.Find(Class))
+		{
+			Instances->Remove(Instance);
+			if (Instances->Num() == 0)
+			{
+				InstancesByType.Remove(Class);
+			}
+		}
+
+		if (Class == UECREquipmentInstance::StaticClass())
+		{
+			break;
+		}
+	}
+}
+
+void FECREquipmentList::RebuildTypeIndex(const TArrayView<int32> ExcludedIndices)
+{
+	InstancesByType.Reset();
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].Instance != nullptr && !ExcludedIndices.Contains(Index))
+		{
+			AddToTypeIndex(Entries[Index].Instance);
+		}
+	}
 }
 
 UECRAbilitySystemComponent* FECREquipmentList::GetAbilitySystemComponent() const
@@ -82,6 +140,7 @@ UECREquipmentInstance* FECREquipmentList::AddEntry(TSubclassOf<UECREquipmentDefi
 	NewEntry.Instance = NewObject<UECREquipmentInstance>(OwnerComponent->GetOwner(), InstanceType);
 	//@TODO: Using the actor instead of component as the outer due to UE-127172
 	Result = NewEntry.Instance;
+	AddToTypeIndex(Result);
 
 	if (UECRAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 	{
@@ -115,7 +174,7 @@ void FECREquipmentList::RemoveEntry(UECREquipmentInstance* Instance)
 			}
 
 			Instance->DestroyEquipmentActors();
-
+			RemoveFromTypeIndex(Instance);
 
 			EntryIt.RemoveCurrent();
 			MarkArrayDirty();
@@ -253,16 +312,13 @@ void UECREquipmentManagerComponent::UninitializeComponent()
 }
 
 UECREquipmentInstance* UECREquipmentManagerComponent::GetFirstInstanceOfType(
-	TSubclassOf<UECREquipmentInstance> InstanceType)
+	TSubclassOf<UECREquipmentInstance> InstanceType) const
 {
-	for (FECRAppliedEquipmentEntry& Entry : EquipmentList.Entries)
+	if (const TArray<UECREquipmentInstance*>* Instances = EquipmentList.FindInstancesOfType(InstanceType))
 	{
-		if (UECREquipmentInstance* Instance = Entry.Instance)
+		if (Instances->Num() > 0)
 		{
-			if (Instance->IsA(InstanceType))
-			{
-				return Instance;
-			}
+			return (*Instances)[0];
 		}
 	}
 
@@ -272,18 +328,11 @@ UECREquipmentInstance* UECREquipmentManagerComponent::GetFirstInstanceOfType(
 TArray<UECREquipmentInstance*> UECREquipmentManagerComponent::GetEquipmentInstancesOfType(
 	TSubclassOf<UECREquipmentInstance> InstanceType) const
 {
-	TArray<UECREquipmentInstance*> Results;
-	for (const FECRAppliedEquipmentEntry& Entry : EquipmentList.Entries)
+	if (const TArray<UECREquipmentInstance*>* Instances = EquipmentList.FindInstancesOfType(InstanceType))
 	{
-		if (UECREquipmentInstance* Instance = Entry.Instance)
-		{
-			if (Instance->IsA(InstanceType))
-			{
-				Results.Add(Instance);
-			}
-		}
+		return *Instances;
 	}
-	return Results;
+	return TArray<UECREquipmentInstance*>();
 }
 
 UECREquipmentInstance* UECREquipmentManagerComponent::GetFirstInstanceVisibleInChannel(const FName VisibilityChannel)
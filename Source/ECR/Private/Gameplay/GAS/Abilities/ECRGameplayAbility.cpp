@@ -18,8 +18,11 @@
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "Gameplay/GAS/ECRAbilitySourceInterface.h"
 #include "Gameplay/GAS/ECRGameplayEffectContext.h"
+#include "Gameplay/GAS/ECRGameplayAbilityTargetData_SingleTargetHit.h"
+#include "Gameplay/GAS/Attributes/ECRHealthSet.h"
 #include "Gameplay/Player/ECRPlayerState.h"
 #include "Physics/PhysicalMaterialWithTags.h"
+#include "System/ECRServerStatsSubsystem.h"
 
 
 #define ENSURE_ABILITY_IS_INSTANTIATED_OR_RETURN(FunctionName, ReturnValue)																				\
@@ -523,6 +526,102 @@ FGameplayEffectContextHandle UECRGameplayAbility::K2_MakeEffectContextHandle()
 	return EffectContextHandle;
 }
 
+int32 UECRGameplayAbility::ApplyGameplayEffectSpecToHits(const FGameplayEffectSpecHandle& SpecHandle,
+                                                       const FGameplayAbilityTargetDataHandle& TargetData)
+{
+	const FGameplayEffectSpec* SourceSpec = SpecHandle.Data.Get();
+	UAbilitySystemComponent* SourceAbilitySystem = GetAbilitySystemComponentFromActorInfo();
+	if (!SourceSpec || !SourceSpec->Def || !SourceAbilitySystem || !HasAuthority(&CurrentActivationInfo))
+	{
+		return 0;
+	}
+
+	// Effects that stay active keep their own spec, nothing to share
+	if (SourceSpec->Def->DurationPolicy != EGameplayEffectDurationType::Instant
+		|| !FECRGameplayEffectContext::ExtractEffectContext(SourceSpec->GetContext()))
+	{
+		return K2_ApplyGameplayEffectSpecToTarget(SpecHandle, TargetData).Num();
+	}
+
+	ECR_SERVER_STAT_SCOPE(BatchedEffectApplication);
+
+	TArray<TPair<UAbilitySystemComponent*, const FGameplayAbilityTargetData*>, TInlineAllocator<32>> Hits;
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : TargetData.Data)
+	{
+		if (!Data.IsValid())
+		{
+			continue;
+		}
+
+		if (const FHitResult* HitResult = Data->GetHitResult())
+		{
+			if (UAbilitySystemComponent* TargetAbilitySystem =
+				UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitResult->GetActor()))
+			{
+				Hits.Emplace(TargetAbilitySystem, Data.Get());
+			}
+			continue;
+		}
+
+		for (const TWeakObjectPtr<AActor>& Actor : Data->GetActors())
+		{
+			if (UAbilitySystemComponent* TargetAbilitySystem =
+				UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor.Get()))
+			{
+				Hits.Emplace(TargetAbilitySystem, Data.Get());
+			}
+		}
+	}
+
+	// Group hits by target in order of the first hit on it, order of hits on one target is kept
+	TArray<UAbilitySystemComponent*, TInlineAllocator<8>> Targets;
+	for (const TPair<UAbilitySystemComponent*, const FGameplayAbilityTargetData*>& Hit : Hits)
+	{
+		Targets.AddUnique(Hit.Key);
+	}
+
+	if (Targets.Num() < Hits.Num())
+	{
+		TArray<TPair<UAbilitySystemComponent*, const FGameplayAbilityTargetData*>, TInlineAllocator<32>> GroupedHits;
+		GroupedHits.Reserve(Hits.Num());
+		for (const UAbilitySystemComponent* Target : Targets)
+		{
+			for (const TPair<UAbilitySystemComponent*, const FGameplayAbilityTargetData*>& Hit : Hits)
+			{
+				if (Hit.Key == Target)
+				{
+					GroupedHits.Add(Hit);
+				}
+			}
+		}
+		Hits = MoveTemp(GroupedHits);
+	}
+
+	// Instant effects execute synchronously, so the spec is reused for all hits. Every hit gets its own context,
+	// gameplay cues and listeners may keep the handle after the execution
+	FGameplayEffectSpec Spec(*SourceSpec);
+
+	const FPredictionKey PredictionKey = CurrentActivationInfo.GetActivationPredictionKey();
+	const UScriptStruct* ECRHitDataStruct = FECRGameplayAbilityTargetData_SingleTargetHit::StaticStruct();
+
+	FECRScopedDamageMessageBatch DamageMessageBatch(GetWorld());
+	for (const TPair<UAbilitySystemComponent*, const FGameplayAbilityTargetData*>& Hit : Hits)
+	{
+		const FGameplayAbilityTargetData* Data = Hit.Value;
+		FGameplayEffectContextHandle Context = SourceSpec->GetContext().Duplicate();
+		FECRGameplayEffectContext* TypedContext = FECRGameplayEffectContext::ExtractEffectContext(Context);
+		TypedContext->ReplaceHitResult(Data->GetHitResult());
+		TypedContext->CartridgeID = Data->GetScriptStruct()->IsChildOf(ECRHitDataStruct)
+			                            ? static_cast<const FECRGameplayAbilityTargetData_SingleTargetHit*>(Data)->CartridgeID
+			                            : -1;
+		Spec.SetContext(Context, /*bSkipRecaptureSourceActorTags=*/ true);
+
+		SourceAbilitySystem->ApplyGameplayEffectSpecToTarget(Spec, Hit.Key, PredictionKey);
+	}
+
+	return Hits.Num();
+}
+
 UAnimMontage* UECRGameplayAbility::GetMontage(const FName MontageCategory) const
 {
 	const FECRAnimMontageSelectionSet AnimMontageSelectionSet = AbilityMontageSelection.FindRef(MontageCategory);
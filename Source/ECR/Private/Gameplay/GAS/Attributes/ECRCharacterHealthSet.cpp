@@ -45,6 +45,8 @@ void UECRCharacterHealthSet::CheckIfReadyToBecomeWounded(const FGameplayEffectMo
 		{
 			bLastTimeWasWounded = true;
 
+			FECRScopedDamageMessageBatch::FlushMessagesTo(GetOwningActor());
+
 			if (OnReadyToBecomeWounded.IsBound())
 			{
 				const FGameplayEffectContextHandle& EffectContext = Data.EffectSpec.GetEffectContext();
@@ -14,6 +14,112 @@ UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_FellOutOfWorld, "Gameplay.Damage.Reason.Fell
 UE_DEFINE_GAMEPLAY_TAG(TAG_ECR_Damage_Message, "ECR.Damage.Message");
 
 
+namespace ECRDamageMessageBatch
+{
+	struct FWorldBatch
+	{
+		int32 ScopeDepth = 0;
+		TArray<FECRVerbMessage> PendingMessages;
+	};
+
+	// Worlds batch separately, PIE instances share the process
+	static TMap<TObjectKey<UWorld>, FWorldBatch> BatchesByWorld;
+
+	static void BroadcastMessages(UWorld* World, const TArray<FECRVerbMessage>& Messages)
+	{
+		if (World == nullptr)
+		{
+			return;
+		}
+
+		UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(World);
+		for (const FECRVerbMessage& Message : Messages)
+		{
+			MessageSystem.BroadcastMessage(Message.Verb, Message);
+		}
+	}
+}
+
+
+FECRScopedDamageMessageBatch::FECRScopedDamageMessageBatch(UWorld* InWorld)
+	: World(InWorld)
+{
+	check(IsInGameThread());
+	ECRDamageMessageBatch::BatchesByWorld.FindOrAdd(World).ScopeDepth++;
+}
+
+
+FECRScopedDamageMessageBatch::~FECRScopedDamageMessageBatch()
+{
+	using namespace ECRDamageMessageBatch;
+
+	FWorldBatch& Batch = BatchesByWorld.FindChecked(World);
+	if (--Batch.ScopeDepth > 0)
+	{
+		return;
+	}
+
+	// Listeners may start another batch, so broadcast from a local copy
+	TArray<FECRVerbMessage> Messages = MoveTemp(Batch.PendingMessages);
+	BatchesByWorld.Remove(World);
+	BroadcastMessages(World.ResolveObjectPtr(), Messages);
+}
+
+
+bool FECRScopedDamageMessageBatch::AddMessage(const FECRVerbMessage& Message, UWorld* World)
+{
+	using namespace ECRDamageMessageBatch;
+
+	FWorldBatch* Batch = BatchesByWorld.Find(World);
+	if (Batch == nullptr)
+	{
+		return false;
+	}
+
+	for (FECRVerbMessage& Pending : Batch->PendingMessages)
+	{
+		if (Pending.Target == Message.Target && Pending.Instigator == Message.Instigator
+			&& Pending.Verb == Message.Verb)
+		{
+			Pending.Magnitude += Message.Magnitude;
+			return true;
+		}
+	}
+
+	Batch->PendingMessages.Add(Message);
+	return true;
+}
+
+
+void FECRScopedDamageMessageBatch::FlushMessagesTo(const AActor* Target)
+{
+	using namespace ECRDamageMessageBatch;
+
+	UWorld* World = Target ? Target->GetWorld() : nullptr;
+	FWorldBatch* Batch = BatchesByWorld.Find(World);
+	if (Batch == nullptr)
+	{
+		return;
+	}
+
+	TArray<FECRVerbMessage> Messages;
+	for (int32 Index = 0; Index < Batch->PendingMessages.Num();)
+	{
+		if (Batch->PendingMessages[Index].Target == Target)
+		{
+			Messages.Add(MoveTemp(Batch->PendingMessages[Index]));
+			Batch->PendingMessages.RemoveAt(Index, 1, false);
+		}
+		else
+		{
+			++Index;
+		}
+	}
+
+	BroadcastMessages(World, Messages);
+}
+
+
 UECRHealthSet::UECRHealthSet()
 	: Health(100.0f),
 	  MaxHealth(100.0f)
@@ -61,6 +167,11 @@ void UECRHealthSet::SendDamageMessage(const FGameplayEffectModCallbackData& Dama
 	//@TODO: Determine if it's an opposing team kill, self-own, team kill, etc...
 	Message.Magnitude = DamageData.EvaluatedData.Magnitude;
 
+	if (FECRScopedDamageMessageBatch::AddMessage(Message, GetWorld()))
+	{
+		return;
+	}
+
 	UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(GetWorld());
 	MessageSystem.BroadcastMessage(Message.Verb, Message);
 }
@@ -75,6 +186,8 @@ void UECRHealthSet::CheckIfReadyToDie(const FGameplayEffectModCallbackData& Data
 {
 	if (GetIsReadyToDie() && !bReadyToDie)
 	{
+		FECRScopedDamageMessageBatch::FlushMessagesTo(GetOwningActor());
+
 		if (OnReadyToDie.IsBound())
 		{
 			const FGameplayEffectContextHandle& EffectContext = Data.EffectSpec.GetEffectContext();
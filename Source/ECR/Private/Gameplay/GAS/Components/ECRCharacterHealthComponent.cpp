@@ -4,6 +4,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/PlayerState.h"
+#include "TimerManager.h"
 #include "Gameplay/ECRGameplayTags.h"
 #include "System/ECRLogChannels.h"
 #include "Gameplay/GAS/ECRAbilitySystemComponent.h"
@@ -31,28 +32,21 @@ void UECRCharacterHealthComponent::InitializeWithAbilitySystem(UECRAbilitySystem
 		return;
 	}
 
-	// Shield
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UECRCharacterHealthSet::GetShieldAttribute()).
-	                        AddUObject(this, &ThisClass::HandleShieldChanged);
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UECRCharacterHealthSet::GetMaxShieldAttribute())
-	                      .
-	                      AddUObject(this, &ThisClass::HandleMaxShieldChanged);
-	OnShieldChanged.Broadcast(this, CharacterHealthSet->GetShield(), CharacterHealthSet->GetShield(), nullptr);
-	OnMaxShieldChanged.Broadcast(this, CharacterHealthSet->GetMaxShield(), CharacterHealthSet->GetMaxShield(),
-	                             nullptr);
-
-	// Bleeding health
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-		                        UECRCharacterHealthSet::GetBleedingHealthAttribute()).
-	                        AddUObject(this, &ThisClass::HandleBleedingHealthChanged);
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-		                        UECRCharacterHealthSet::GetMaxBleedingHealthAttribute()).
-	                        AddUObject(this, &ThisClass::HandleMaxBleedingHealthChanged);
-	OnBleedingHealthChanged.Broadcast(this, CharacterHealthSet->GetBleedingHealth(),
-	                                  CharacterHealthSet->GetBleedingHealth(), nullptr);
-	OnMaxBleedingHealthChanged.Broadcast(this, CharacterHealthSet->GetMaxBleedingHealth(),
-	                                     CharacterHealthSet->GetMaxBleedingHealth(),
-	                                     nullptr);
+	// Shield, bleeding health and stamina changes are collected and broadcast once per frame
+	TArray<FECRAttributeChange> InitialValues;
+	ForEachObservedAttribute([this, &InitialValues](const FGameplayAttribute& Attribute)
+	{
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(
+			this, &ThisClass::HandleObservedAttributeChanged);
+
+		const float Value = AbilitySystemComponent->GetNumericAttribute(Attribute);
+		FECRAttributeChange& Change = InitialValues.AddDefaulted_GetRef();
+		Change.Attribute = Attribute;
+		Change.OldValue = Value;
+		Change.NewValue = Value;
+		BroadcastAttributeChange(Change);
+	});
+	OnAttributesChanged.Broadcast(this, InitialValues);
 
 	CharacterHealthSet->OnReadyToBecomeWounded.AddUObject(this, &ThisClass::HandleReadyToBecomeWounded);
 	CharacterHealthSet->OnReadyToBecomeUnwounded.AddUObject(this, &ThisClass::HandleReadyToBecomeUnwounded);
@@ -60,49 +54,40 @@ void UECRCharacterHealthComponent::InitializeWithAbilitySystem(UECRAbilitySystem
 
 	if (CharacterMovementSet)
 	{
-		// Root motion scale
+		// Root motion scale and speed are applied to movement right away
 		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
 			UECRMovementSet::GetRootMotionScaleAttribute()).AddUObject(
 			this, &ThisClass::HandleRootMotionScaleChanged);
 		ChangeCharacterRootMotionScale(CharacterMovementSet->GetRootMotionScale());
 
-		// Speed
 		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UECRMovementSet::GetWalkSpeedAttribute()).
 		                        AddUObject(this, &ThisClass::HandleWalkSpeedChanged);
 		ChangeCharacterSpeed(CharacterMovementSet->GetWalkSpeed());
-
-		// Stamina
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UECRMovementSet::GetStaminaAttribute()).
-		                        AddUObject(this, &ThisClass::HandleStaminaChanged);
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UECRMovementSet::GetMaxStaminaAttribute()).
-		                        AddUObject(this, &ThisClass::HandleMaxStaminaChanged);
-		OnStaminaChanged.Broadcast(this, CharacterMovementSet->GetStamina(), CharacterMovementSet->GetStamina(),
-		                           nullptr);
-		OnMaxStaminaChanged.Broadcast(this, CharacterMovementSet->GetMaxStamina(),
-		                              CharacterMovementSet->GetMaxStamina(),
-		                              nullptr);
-
-		// Evasion stamina
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-			                        UECRMovementSet::GetEvasionStaminaAttribute()).
-		                        AddUObject(this, &ThisClass::HandleEvasionStaminaChanged);
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-			                        UECRMovementSet::GetMaxEvasionStaminaAttribute()).
-		                        AddUObject(this, &ThisClass::HandleMaxEvasionStaminaChanged);
-		OnEvasionStaminaChanged.Broadcast(this, CharacterMovementSet->GetEvasionStamina(),
-		                                  CharacterMovementSet->GetEvasionStamina(), nullptr);
-		OnMaxEvasionStaminaChanged.Broadcast(this, CharacterMovementSet->GetMaxEvasionStamina(),
-		                                     CharacterMovementSet->GetMaxEvasionStamina(), nullptr);
 	}
 }
 
 void UECRCharacterHealthComponent::UninitializeFromAbilitySystem()
 {
+	if (AbilitySystemComponent)
+	{
+		ForEachObservedAttribute([this](const FGameplayAttribute& Attribute)
+		{
+			AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
+		});
+	}
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AttributeChangeFlushHandle);
+	}
+	PendingAttributeChanges.Reset();
+
 	if (CharacterHealthSet)
 	{
 		CharacterHealthSet->OnReadyToBecomeWounded.RemoveAll(this);
 	}
 	CharacterHealthSet = nullptr;
+	CharacterMovementSet = nullptr;
 
 	Super::UninitializeFromAbilitySystem();
 }
@@ -215,30 +200,6 @@ void UECRCharacterHealthComponent::HandleWalkSpeedChanged(const FOnAttributeChan
 	ChangeCharacterSpeed(NewSpeed);
 }
 
-void UECRCharacterHealthComponent::HandleShieldChanged(const FOnAttributeChangeData& ChangeData)
-{
-	OnShieldChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                          GetInstigatorFromAttrChangeData(ChangeData));
-}
-
-void UECRCharacterHealthComponent::HandleMaxShieldChanged(const FOnAttributeChangeData& ChangeData)
-{
-	OnMaxShieldChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                             GetInstigatorFromAttrChangeData(ChangeData));
-}
-
-void UECRCharacterHealthComponent::HandleBleedingHealthChanged(const FOnAttributeChangeData& ChangeData)
-{
-	OnBleedingHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                                  GetInstigatorFromAttrChangeData(ChangeData));
-}
-
-void UECRCharacterHealthComponent::HandleMaxBleedingHealthChanged(const FOnAttributeChangeData& ChangeData)
-{
-	OnMaxBleedingHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                                     GetInstigatorFromAttrChangeData(ChangeData));
-}
-
 void UECRCharacterHealthComponent::HandleReadyToBecomeWounded(AActor* DamageInstigator, AActor* DamageCauser,
                                                               const FGameplayEffectSpec& DamageEffectSpec,
                                                               float DamageMagnitude)
@@ -254,7 +215,8 @@ void UECRCharacterHealthComponent::HandleReadyToBecomeWounded(AActor* DamageInst
 			Payload.Instigator = DamageInstigator;
 			Payload.Target = AbilitySystemComponent->GetAvatarActor();
 			Payload.OptionalObject = DamageEffectSpec.Def;
-			Payload.ContextHandle = DamageEffectSpec.GetEffectContext();
+			// Batched damage reuses one context for all hits, abilities triggered here can outlive it
+			Payload.ContextHandle = DamageEffectSpec.GetEffectContext().Duplicate();
 			Payload.InstigatorTags = *DamageEffectSpec.CapturedSourceTags.GetAggregatedTags();
 			Payload.TargetTags = *DamageEffectSpec.CapturedTargetTags.GetAggregatedTags();
 			Payload.EventMagnitude = DamageMagnitude;
@@ -299,7 +261,7 @@ void UECRCharacterHealthComponent::HandleReadyToBecomeUnwounded(AActor* EffectIn
 			Payload.Instigator = EffectInstigator;
 			Payload.Target = AbilitySystemComponent->GetAvatarActor();
 			Payload.OptionalObject = EffectSpec.Def;
-			Payload.ContextHandle = EffectSpec.GetEffectContext();
+			Payload.ContextHandle = EffectSpec.GetEffectContext().Duplicate();
 			Payload.InstigatorTags = *EffectSpec.CapturedSourceTags.GetAggregatedTags();
 			Payload.TargetTags = *EffectSpec.CapturedTargetTags.GetAggregatedTags();
 			Payload.EventMagnitude = EffectMagnitude;
@@ -312,28 +274,119 @@ void UECRCharacterHealthComponent::HandleReadyToBecomeUnwounded(AActor* EffectIn
 }
 
 
-void UECRCharacterHealthComponent::HandleStaminaChanged(const FOnAttributeChangeData& ChangeData)
+void UECRCharacterHealthComponent::ForEachObservedAttribute(
+	TFunctionRef<void(const FGameplayAttribute& Attribute)> Func) const
 {
-	OnStaminaChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                           GetInstigatorFromAttrChangeData(ChangeData));
+	if (CharacterHealthSet)
+	{
+		Func(UECRCharacterHealthSet::GetShieldAttribute());
+		Func(UECRCharacterHealthSet::GetMaxShieldAttribute());
+		Func(UECRCharacterHealthSet::GetBleedingHealthAttribute());
+		Func(UECRCharacterHealthSet::GetMaxBleedingHealthAttribute());
+	}
+
+	if (CharacterMovementSet)
+	{
+		Func(UECRMovementSet::GetStaminaAttribute());
+		Func(UECRMovementSet::GetMaxStaminaAttribute());
+		Func(UECRMovementSet::GetEvasionStaminaAttribute());
+		Func(UECRMovementSet::GetMaxEvasionStaminaAttribute());
+	}
 }
 
-void UECRCharacterHealthComponent::HandleMaxStaminaChanged(const FOnAttributeChangeData& ChangeData)
+void UECRCharacterHealthComponent::HandleObservedAttributeChanged(const FOnAttributeChangeData& ChangeData)
 {
-	OnMaxStaminaChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                              GetInstigatorFromAttrChangeData(ChangeData));
+	AActor* Instigator = GetInstigatorFromAttrChangeData(ChangeData);
+
+	// Several changes of an attribute in one frame (regeneration ticks, multiple hits) become one change
+	for (FECRAttributeChange& Change : PendingAttributeChanges)
+	{
+		if (Change.Attribute == ChangeData.Attribute)
+		{
+			Change.NewValue = ChangeData.NewValue;
+			Change.Instigator = Instigator ? Instigator : Change.Instigator;
+			return;
+		}
+	}
+
+	FECRAttributeChange& Change = PendingAttributeChanges.AddDefaulted_GetRef();
+	Change.Attribute = ChangeData.Attribute;
+	Change.OldValue = ChangeData.OldValue;
+	Change.NewValue = ChangeData.NewValue;
+	Change.Instigator = Instigator;
+
+	if (!AttributeChangeFlushHandle.IsValid())
+	{
+		AttributeChangeFlushHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(
+			this, &ThisClass::FlushAttributeChanges);
+	}
 }
 
-void UECRCharacterHealthComponent::HandleEvasionStaminaChanged(const FOnAttributeChangeData& ChangeData)
+void UECRCharacterHealthComponent::FlushAttributeChanges()
 {
-	OnEvasionStaminaChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                                  GetInstigatorFromAttrChangeData(ChangeData));
+	AttributeChangeFlushHandle.Invalidate();
+
+	// Listeners may change attributes again, those changes are collected for the next frame
+	Swap(PendingAttributeChanges, FlushedAttributeChanges);
+
+	// Changes that cancelled out during the frame are dropped
+	FlushedAttributeChanges.RemoveAll([](const FECRAttributeChange& Change)
+	{
+		return Change.OldValue == Change.NewValue;
+	});
+
+	if (FlushedAttributeChanges.Num() > 0)
+	{
+		for (const FECRAttributeChange& Change : FlushedAttributeChanges)
+		{
+			BroadcastAttributeChange(Change);
+		}
+		OnAttributesChanged.Broadcast(this, FlushedAttributeChanges);
+	}
+
+	FlushedAttributeChanges.Reset();
 }
 
-void UECRCharacterHealthComponent::HandleMaxEvasionStaminaChanged(const FOnAttributeChangeData& ChangeData)
+void UECRCharacterHealthComponent::BroadcastAttributeChange(const FECRAttributeChange& Change)
 {
-	OnMaxEvasionStaminaChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue,
-	                                     GetInstigatorFromAttrChangeData(ChangeData));
+	FECRHealth_AttributeChanged* Delegate = nullptr;
+	if (Change.Attribute == UECRCharacterHealthSet::GetShieldAttribute())
+	{
+		Delegate = &OnShieldChanged;
+	}
+	else if (Change.Attribute == UECRCharacterHealthSet::GetMaxShieldAttribute())
+	{
+		Delegate = &OnMaxShieldChanged;
+	}
+	else if (Change.Attribute == UECRCharacterHealthSet::GetBleedingHealthAttribute())
+	{
+		Delegate = &OnBleedingHealthChanged;
+	}
+	else if (Change.Attribute == UECRCharacterHealthSet::GetMaxBleedingHealthAttribute())
+	{
+		Delegate = &OnMaxBleedingHealthChanged;
+	}
+	else if (Change.Attribute == UECRMovementSet::GetStaminaAttribute())
+	{
+		Delegate = &OnStaminaChanged;
+	}
+	else if (Change.Attribute == UECRMovementSet::GetMaxStaminaAttribute())
+	{
+		Delegate = &OnMaxStaminaChanged;
+	}
+	else if (Change.Attribute == UECRMovementSet::GetEvasionStaminaAttribute())
+	{
+		Delegate = &OnEvasionStaminaChanged;
+	}
+	else if (Change.Attribute == UECRMovementSet::GetMaxEvasionStaminaAttribute())
+	{
+		Delegate = &OnMaxEvasionStaminaChanged;
+	}
+
+	if (Delegate)
+	{
+		Delegate->Broadcast(this, Change.OldValue, Change.NewValue, Change.Instigator);
+	}
 }
 
 float UECRCharacterHealthComponent::GetDamageToKill()
@@ -176,7 +176,8 @@ void UECRHealthComponent::HandleReadyToDie(AActor* DamageInstigator, AActor* Dam
 			Payload.Instigator = DamageInstigator;
 			Payload.Target = AbilitySystemComponent->GetAvatarActor();
 			Payload.OptionalObject = DamageEffectSpec.Def;
-			Payload.ContextHandle = DamageEffectSpec.GetEffectContext();
+			// Batched damage reuses one context for all hits, abilities triggered here can outlive it
+			Payload.ContextHandle = DamageEffectSpec.GetEffectContext().Duplicate();
 			Payload.InstigatorTags = *DamageEffectSpec.CapturedSourceTags.GetAggregatedTags();
 			Payload.TargetTags = *DamageEffectSpec.CapturedTargetTags.GetAggregatedTags();
 			Payload.EventMagnitude = DamageMagnitude;
@@ -50,3 +50,24 @@ const UPhysicalMaterial* FECRGameplayEffectContext::GetPhysicalMaterial() const
 	}
 	return nullptr;
 }
+
+
+void FECRGameplayEffectContext::ReplaceHitResult(const FHitResult* InHitResult)
+{
+	if (!InHitResult)
+	{
+		HitResult.Reset();
+		return;
+	}
+
+	if (HitResult.IsValid() && HitResult.IsUnique())
+	{
+		*HitResult = *InHitResult;
+	}
+	else
+	{
+		HitResult = MakeShared<FHitResult>(*InHitResult);
+	}
+
+	AddOrigin(InHitResult->TraceStart);
+}
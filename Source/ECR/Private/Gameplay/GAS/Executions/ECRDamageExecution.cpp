@@ -8,6 +8,7 @@
 #include "Gameplay/GAS/ECRAbilitySourceInterface.h"
 #include "Gameplay/GAS/Attributes/ECRCombatSet.h"
 #include "System/ECRLogChannels.h"
+#include "System/ECRServerStatsSubsystem.h"
 
 struct FDamageStatics
 {
@@ -48,6 +49,7 @@ void UECRDamageExecution::Execute_Implementation(const FGameplayEffectCustomExec
                                                  FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
 #if WITH_SERVER_CODE
+	ECR_SERVER_STAT_SCOPE(DamageExecution);
 
 	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
 	FECRGameplayEffectContext* TypedContext = FECRGameplayEffectContext::ExtractEffectContext(Spec.GetContext());
@@ -55,7 +57,6 @@ void UECRDamageExecution::Execute_Implementation(const FGameplayEffectCustomExec
 
 	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
 	const FGameplayTagContainer* TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
-	// ExecutionParams.GetOwningSpec().GetModifierMagnitude(0, false);
 
 	FAggregatorEvaluateParameters EvaluateParameters;
 	EvaluateParameters.SourceTags = SourceTags;
@@ -122,23 +123,27 @@ void UECRDamageExecution::Execute_Implementation(const FGameplayEffectCustomExec
 		       ), *GetPathNameSafe(Spec.Def))
 	}
 
-	// Apply ability source modifiers
+	// Apply ability source modifiers. Cheapest first, so hits fully stopped by armor skip the other lookups
 	float PhysicalMaterialAttenuation = 1.0f;
 	float DistanceAttenuation = 1.0f;
 	float ToughnessAttenuation = 1.0f;
 
 	if (const IECRAbilitySourceInterface* AbilitySource = TypedContext->GetAbilitySource())
 	{
-		if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
-		{
-			PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(
-				PhysMat, SourceTags, TargetTags);
-		}
-
-		DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
-
 		ToughnessAttenuation = UECRGameplayBlueprintLibrary::CalculateDamageAttenuationForArmorPenetration(
 			AbilitySource->GetArmorPenetration(), TargetToughness, TargetArmor);
+
+		if (ToughnessAttenuation > 0.0f && BaseDamage > 0.0f)
+		{
+			// Looked up in the table baked by the weapon, no tag matching per hit
+			if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
+			{
+				PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(
+					PhysMat, SourceTags, TargetTags);
+			}
+
+			DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
+		}
 	}
 
 	DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
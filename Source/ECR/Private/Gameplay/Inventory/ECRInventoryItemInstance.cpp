@@ -3,6 +3,7 @@
 #include "Gameplay/Inventory/ECRInventoryItemInstance.h"
 #include "Net/UnrealNetwork.h"
 #include "Gameplay/Inventory/ECRInventoryItemDefinition.h"
+#include "Gameplay/Inventory/ECRInventoryManagerComponent.h"
 
 UECRInventoryItemInstance::UECRInventoryItemInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -45,6 +46,24 @@ void UECRInventoryItemInstance::SetItemDef(TSubclassOf<UECRInventoryItemDefiniti
 	QuickBarChannelName = ItemDefCDO->QuickBarChannelName;
 }
 
+void UECRInventoryItemInstance::OnRep_ItemDef()
+{
+	if (ItemDef != nullptr)
+	{
+		QuickBarChannelName = GetDefault<UECRInventoryItemDefinition>(ItemDef)->QuickBarChannelName;
+	}
+
+	// The definition can arrive after the inventory entry was replicated, so the entry couldn't be indexed yet
+	if (const AActor* OwningActor = GetTypedOuter<AActor>())
+	{
+		TInlineComponentArray<UECRInventoryManagerComponent*> InventoryComponents(OwningActor);
+		for (UECRInventoryManagerComponent* InventoryComponent : InventoryComponents)
+		{
+			InventoryComponent->HandleItemDefReplicated(this);
+		}
+	}
+}
+
 const UECRInventoryItemFragment* UECRInventoryItemInstance::FindFragmentByClass(
 	TSubclassOf<UECRInventoryItemFragment> FragmentClass) const
 {
@@ -30,12 +30,21 @@ FString FECRInventoryEntry::GetDebugString() const
 
 void FECRInventoryList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	bool bRemovedUnknownInstance = false;
 	for (int32 Index : RemovedIndices)
 	{
 		FECRInventoryEntry& Stack = Entries[Index];
+		bRemovedUnknownInstance |= Stack.Instance == nullptr;
+		RemoveFromDefinitionIndex(Stack.Instance);
 		BroadcastChangeMessage(Stack, /*OldCount=*/ Stack.StackCount, /*NewCount=*/ 0);
 		Stack.LastObservedCount = 0;
 	}
+
+	// The index may still hold the instance the entry referenced before it was cleared
+	if (bRemovedUnknownInstance)
+	{
+		RebuildDefinitionIndex(RemovedIndices);
+	}
 }
 
 void FECRInventoryList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
@@ -43,6 +52,7 @@ void FECRInventoryList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 	for (int32 Index : AddedIndices)
 	{
 		FECRInventoryEntry& Stack = Entries[Index];
+		AddToDefinitionIndex(Stack.Instance);
 		BroadcastChangeMessage(Stack, /*OldCount=*/ 0, /*NewCount=*/ Stack.StackCount);
 		Stack.LastObservedCount = Stack.StackCount;
 	}
@@ -53,6 +63,8 @@ void FECRInventoryList::PostReplicatedChange(const TArrayView<int32> ChangedIndi
 	for (int32 Index : ChangedIndices)
 	{
 		FECRInventoryEntry& Stack = Entries[Index];
+		// The instance may not have been resolved yet when the entry was added
+		AddToDefinitionIndex(Stack.Instance);
 		check(Stack.LastObservedCount != INDEX_NONE);
 		BroadcastChangeMessage(Stack, /*OldCount=*/ Stack.LastObservedCount, /*NewCount=*/ Stack.StackCount);
 		Stack.LastObservedCount = Stack.StackCount;
@@ -71,6 +83,60 @@ void FECRInventoryList::BroadcastChangeMessage(FECRInventoryEntry& Entry, int32
 	MessageSystem.BroadcastMessage(TAG_ECR_Inventory_Message_StackChanged, Message);
 }
 
+void FECRInventoryList::AddToDefinitionIndex(UECRInventoryItemInstance* Instance)
+{
+	if (Instance != nullptr && Instance->GetItemDef() != nullptr)
+	{
+		InstancesByDefinition.FindOrAdd(Instance->GetItemDef()).AddUnique(Instance);
+	}
+}
+
+void FECRInventoryList::RemoveFromDefinitionIndex(UECRInventoryItemInstance* Instance)
+{
+	if (Instance == nullptr)
+	{
+		return;
+	}
+
+	if (TArray<UECRInventoryItemInstance*>* Instances = InstancesByDefinition.Find(Instance->GetItemDef()))
+	{
+		Instances->Remove(Instance);
+		if (Instances->Num() == 0)
+		{
+			InstancesByDefinition.Remove(Instance->GetItemDef());
+		}
+	}
+}
+
+void FECRInventoryList::RebuildDefinitionIndex(const TArrayView<int32> ExcludedIndices)
+{
+	InstancesByDefinition.Reset();
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (!ExcludedIndices.Contains(Index))
+		{
+			AddToDefinitionIndex(Entries[Index].Instance);
+		}
+	}
+}
+
+const TArray<UECRInventoryItemInstance*>* FECRInventoryList::FindInstancesByDefinition(TSubclassOf<UECRInventoryItemDefinition> ItemDef) const
+{
+	return InstancesByDefinition.Find(ItemDef);
+}
+
+void FECRInventoryList::HandleItemDefReplicated(UECRInventoryItemInstance* Instance)
+{
+	for (const FECRInventoryEntry& Entry : Entries)
+	{
+		if (Entry.Instance == Instance)
+		{
+			AddToDefinitionIndex(Instance);
+			return;
+		}
+	}
+}
+
 UECRInventoryItemInstance* FECRInventoryList::AddEntry(TSubclassOf<UECRInventoryItemDefinition> ItemDef, int32 StackCount)
 {
 	UECRInventoryItemInstance* Result = nullptr;
@@ -94,6 +160,7 @@ UECRInventoryItemInstance* FECRInventoryList::AddEntry(TSubclassOf<UECRInventory
 	}
 	NewEntry.StackCount = StackCount;
 	Result = NewEntry.Instance;
+	AddToDefinitionIndex(Result);
 
 	//const UECRInventoryItemDefinition* ItemCDO = GetDefault<UECRInventoryItemDefinition>(ItemDef);
 	MarkItemDirty(NewEntry);
@@ -113,6 +180,7 @@ void FECRInventoryList::RemoveEntry(UECRInventoryItemInstance* Instance)
 		FECRInventoryEntry& Entry = *EntryIt;
 		if (Entry.Instance == Instance)
 		{
+			RemoveFromDefinitionIndex(Instance);
 			EntryIt.RemoveCurrent();
 			MarkArrayDirty();
 		}
@@ -183,13 +251,11 @@ TArray<UECRInventoryItemInstance*> UECRInventoryManagerComponent::GetAllItems()
 
 UECRInventoryItemInstance* UECRInventoryManagerComponent::FindFirstItemStackByDefinition(TSubclassOf<UECRInventoryItemDefinition> ItemDef) const
 {
-	for (const FECRInventoryEntry& Entry : InventoryList.Entries)
+	if (const TArray<UECRInventoryItemInstance*>* Instances = InventoryList.FindInstancesByDefinition(ItemDef))
 	{
-		UECRInventoryItemInstance* Instance = Entry.Instance;
-
-		if (IsValid(Instance))
+		for (UECRInventoryItemInstance* Instance : *Instances)
 		{
-			if (Instance->GetItemDef() == ItemDef)
+			if (IsValid(Instance))
 			{
 				return Instance;
 			}
@@ -202,13 +268,11 @@ UECRInventoryItemInstance* UECRInventoryManagerComponent::FindFirstItemStackByDe
 int32 UECRInventoryManagerComponent::GetTotalItemCountByDefinition(TSubclassOf<UECRInventoryItemDefinition> ItemDef) const
 {
 	int32 TotalCount = 0;
-	for (const FECRInventoryEntry& Entry : InventoryList.Entries)
+	if (const TArray<UECRInventoryItemInstance*>* Instances = InventoryList.FindInstancesByDefinition(ItemDef))
 	{
-		UECRInventoryItemInstance* Instance = Entry.Instance;
-
-		if (IsValid(Instance))
+		for (UECRInventoryItemInstance* Instance : *Instances)
 		{
-			if (Instance->GetItemDef() == ItemDef)
+			if (IsValid(Instance))
 			{
 				++TotalCount;
 			}
@@ -226,7 +290,6 @@ bool UECRInventoryManagerComponent::ConsumeItemsByDefinition(TSubclassOf<UECRInv
 		return false;
 	}
 
-	//@TODO: N squared right now as there's no acceleration structure
 	int32 TotalConsumed = 0;
 	while (TotalConsumed < NumToConsume)
 	{
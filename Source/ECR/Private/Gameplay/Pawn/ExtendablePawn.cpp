@@ -1,6 +1,7 @@
 ﻿#include "Gameplay/Pawn/ExtendablePawn.h"
 
 #include "Gameplay/Character/ECRPawnExtensionComponent.h"
+#include "Gameplay/ECRGameMode.h"
 
 AExtendablePawn::AExtendablePawn(const FObjectInitializer& ObjectInitializer)
 {
@@ -41,3 +42,11 @@ void AExtendablePawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComp
 
 	PawnExtComponent->SetupPlayerInputComponent();
 }
+
+bool AExtendablePawn::IsReplayRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation,
+                                          const float CullDistance) const
+{
+	// Server replays keep players at the full rate, not only while another player sees them
+	return AECRGameMode::IsCriticalForReplay(this)
+		|| Super::IsReplayRelevantFor(RealViewer, ViewTarget, SrcLocation, CullDistance);
+}
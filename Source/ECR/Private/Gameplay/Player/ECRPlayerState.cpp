@@ -6,6 +6,7 @@
 #include "Net/UnrealNetwork.h"
 #include "Gameplay/Character/ECRPawnExtensionComponent.h"
 #include "Components/GameFrameworkComponentManager.h"
+#include "Customization/CustomizationPrefetchSubsystem.h"
 
 
 AECRPlayerState::AECRPlayerState(const FObjectInitializer& ObjectInitializer)
@@ -22,6 +23,8 @@ void AECRPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 	// SharedParams.bIsPushBased = true;
 
 	DOREPLIFETIME(ThisClass, StatTags);
+	DOREPLIFETIME(ThisClass, CustomizationElementaryAssets);
+	DOREPLIFETIME(ThisClass, CustomizationMaterialConfigs);
 }
 
 void AECRPlayerState::PreInitializeComponents()
@@ -66,6 +69,33 @@ int32 AECRPlayerState::GetStatTagStackCount(FGameplayTag Tag) const
 	return StatTags.GetStackCount(Tag);
 }
 
+void AECRPlayerState::SetCustomizationLoadout(
+	const TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+	const TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs)
+{
+	CustomizationElementaryAssets = ElementaryAssets;
+	CustomizationMaterialConfigs = MaterialConfigs;
+
+	// Listen server host streams it in too
+	OnRep_CustomizationLoadout();
+}
+
+void AECRPlayerState::GetCustomizationLoadout_Implementation(
+	TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+	TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs) const
+{
+	ElementaryAssets = CustomizationElementaryAssets;
+	MaterialConfigs = CustomizationMaterialConfigs;
+}
+
+void AECRPlayerState::OnRep_CustomizationLoadout()
+{
+	if (UCustomizationPrefetchSubsystem* PrefetchSubsystem = UCustomizationPrefetchSubsystem::Get(this))
+	{
+		PrefetchSubsystem->PrefetchLoadoutOf(this);
+	}
+}
+
 void AECRPlayerState::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
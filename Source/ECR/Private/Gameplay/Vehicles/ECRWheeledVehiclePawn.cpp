@@ -4,7 +4,9 @@
 #include "Gameplay/Vehicles/ECRWheeledVehiclePawn.h"
 
 #include "ChaosVehicleMovementComponent.h"
+#include "ChaosWheeledVehicleMovementComponent.h"
 #include "Gameplay/Camera/ECRCameraComponent.h"
+#include "Gameplay/ECRGameMode.h"
 #include "Gameplay/Character/ECRPawnData.h"
 #include "Gameplay/Character/ECRPawnExtensionComponent.h"
 #include "Gameplay/GAS/ECRAbilitySet.h"
@@ -14,7 +16,129 @@
 #include "Gameplay/GAS/Attributes/ECRSimpleVehicleHealthSet.h"
 #include "Gameplay/GAS/Components/ECRHealthComponent.h"
 #include "Gameplay/Player/ECRPlayerState.h"
+#include "System/ECRLogChannels.h"
+#include "HAL/IConsoleManager.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+
+
+namespace ECRVehicleReplication
+{
+	static bool bAdaptive = true;
+	static FAutoConsoleVariableRef CVarAdaptive(
+		TEXT("ECR.Vehicle.AdaptiveReplication"),
+		bAdaptive,
+		TEXT("Adapt vehicle update frequency, cull distance and dormancy to occupancy and movement"),
+		ECVF_Default);
+
+	static bool bSimulationLOD = true;
+	static FAutoConsoleVariableRef CVarSimulationLOD(
+		TEXT("ECR.Vehicle.SimulationLOD"),
+		bSimulationLOD,
+		TEXT("Reduce server simulation fidelity of vehicles nobody drives or watches closely"),
+		ECVF_Default);
+
+	// Headless check that reduced simulation stays close to full simulation. Run in a flat test map with
+	//   ECR.Vehicle.TestSimulationLOD Class=<vehicle class path> [Duration=5] [Tolerance=50] [ExitWhenDone]
+	// Two vehicles side by side drive with the same inputs, one at full and one at reduced simulation, and
+	// the difference of their displacements must stay within the tolerance.
+	static void TestSimulationLOD(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || !World->IsGameWorld())
+		{
+			UE_LOG(LogECR, Warning, TEXT("ECR.Vehicle.TestSimulationLOD needs a game world"));
+			return;
+		}
+
+		const FString CommandLine = FString::Join(Args, TEXT(" "));
+		const bool bExitWhenDone = Args.Contains(TEXT("ExitWhenDone"));
+
+		FString ClassPath;
+		FParse::Value(*CommandLine, TEXT("Class="), ClassPath);
+
+		float Duration = 5.0f;
+		FParse::Value(*CommandLine, TEXT("Duration="), Duration);
+
+		float Tolerance = 50.0f;
+		FParse::Value(*CommandLine, TEXT("Tolerance="), Tolerance);
+
+		UClass* VehicleClass = ClassPath.IsEmpty() ? nullptr : LoadClass<AECRWheeledVehiclePawn>(nullptr, *ClassPath);
+		if (VehicleClass == nullptr)
+		{
+			UE_LOG(LogECR, Error, TEXT("Vehicle simulation LOD test: no vehicle class %s"), *ClassPath);
+			if (bExitWhenDone)
+			{
+				FPlatformMisc::RequestExitWithStatus(false, 1);
+			}
+			return;
+		}
+
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.ObjectFlags |= RF_Transient;
+		SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<TWeakObjectPtr<AECRWheeledVehiclePawn>> Vehicles;
+		TArray<FVector> StartLocations;
+		for (const EECRVehicleSimulationLOD LOD : {EECRVehicleSimulationLOD::Full, EECRVehicleSimulationLOD::Reduced})
+		{
+			const FVector Location(0.0f, LOD == EECRVehicleSimulationLOD::Full ? -1000.0f : 1000.0f, 100.0f);
+			AECRWheeledVehiclePawn* Vehicle = World->SpawnActor<AECRWheeledVehiclePawn>(
+				VehicleClass, FTransform(Location), SpawnInfo);
+			if (Vehicle == nullptr)
+			{
+				continue;
+			}
+
+			Vehicle->SetSimulationLOD(LOD, true);
+
+			UChaosVehicleMovementComponent* Movement = Vehicle->GetVehicleMovementComponent();
+			Movement->bRequiresControllerForInputs = false;
+			Movement->SetThrottleInput(1.0f);
+			Movement->SetSteeringInput(0.25f);
+
+			Vehicles.Add(Vehicle);
+			StartLocations.Add(Location);
+		}
+
+		auto CompareTrajectories = [Vehicles, StartLocations, Tolerance, bExitWhenDone]()
+		{
+			bool bPassed = Vehicles.Num() == 2 && Vehicles[0].IsValid() && Vehicles[1].IsValid();
+			if (bPassed)
+			{
+				const FVector FullDisplacement = Vehicles[0]->GetActorLocation() - StartLocations[0];
+				const FVector ReducedDisplacement = Vehicles[1]->GetActorLocation() - StartLocations[1];
+				const float Drift = FVector::Dist(FullDisplacement, ReducedDisplacement);
+				bPassed = Drift <= Tolerance;
+
+				UE_LOG(LogECR, Log, TEXT("Vehicle simulation LOD test: travelled %.0f, drift %.1f (tolerance %.1f)"),
+				       FullDisplacement.Size(), Drift, Tolerance);
+			}
+
+			for (const TWeakObjectPtr<AECRWheeledVehiclePawn>& Vehicle : Vehicles)
+			{
+				if (Vehicle.IsValid())
+				{
+					Vehicle->Destroy();
+				}
+			}
+
+			UE_LOG(LogECR, Log, TEXT("Vehicle simulation LOD test %s"), bPassed ? TEXT("passed") : TEXT("failed"));
+			if (bExitWhenDone)
+			{
+				FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+			}
+		};
+
+		FTimerHandle TimerHandle;
+		World->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateLambda(CompareTrajectories),
+		                                  FMath::Max(Duration, 0.1f), false);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdTestSimulationLOD(
+		TEXT("ECR.Vehicle.TestSimulationLOD"),
+		TEXT("Compares trajectories of full and reduced vehicle simulation. Usage: ECR.Vehicle.TestSimulationLOD Class=<path> [Duration=5] [Tolerance=50] [ExitWhenDone]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(TestSimulationLOD));
+}
 
 
 AECRWheeledVehiclePawn::AECRWheeledVehiclePawn(const FObjectInitializer& ObjectInitializer)
@@ -24,9 +148,9 @@ AECRWheeledVehiclePawn::AECRWheeledVehiclePawn(const FObjectInitializer& ObjectI
 	PrimaryActorTick.bCanEverTick = false;
 	PrimaryActorTick.bStartWithTickEnabled = false;
 	
-	// AbilitySystemComponent needs to be updated at a high frequency.
-	NetUpdateFrequency = 100.0f;
-	NetCullDistanceSquared = 900000000.0f;
+	// Driven vehicles near players need a high frequency, UpdateReplicationPolicy lowers it when they aren't
+	NetUpdateFrequency = DrivenNearNetUpdateFrequency;
+	NetCullDistanceSquared = ActiveNetCullDistanceSquared;
 
 	// Ability system component
 	AbilitySystemComponent = ObjectInitializer.CreateDefaultSubobject<UECRAbilitySystemComponent>(
@@ -118,6 +242,232 @@ void AECRWheeledVehiclePawn::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
 	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, PawnData, SharedParams);
 }
 
+void AECRWheeledVehiclePawn::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (const UChaosWheeledVehicleMovementComponent* WheeledMovement =
+		Cast<UChaosWheeledVehicleMovementComponent>(GetVehicleMovementComponent()))
+	{
+		for (const UChaosVehicleWheel* Wheel : WheeledMovement->Wheels)
+		{
+			ConfiguredSweepShapes.Add(Wheel ? Wheel->SweepShape : ESweepShape::Raycast);
+		}
+	}
+
+	if (HasAuthority())
+	{
+		AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddUObject(
+			this, &ThisClass::HandleGameplayEffectExecuted);
+		AbilitySystemComponent->OnPeriodicGameplayEffectExecuteDelegateOnSelf.AddUObject(
+			this, &ThisClass::HandleGameplayEffectExecuted);
+
+		// Random first delay spreads vehicles placed in the map across frames
+		GetWorldTimerManager().SetTimer(ReplicationPolicyTimerHandle, this, &ThisClass::UpdateReplicationPolicy,
+		                                ReplicationPolicyInterval, true,
+		                                FMath::FRandRange(0.0f, ReplicationPolicyInterval));
+	}
+}
+
+void AECRWheeledVehiclePawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(ReplicationPolicyTimerHandle);
+	AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.RemoveAll(this);
+	AbilitySystemComponent->OnPeriodicGameplayEffectExecuteDelegateOnSelf.RemoveAll(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float AECRWheeledVehiclePawn::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer,
+                                             AActor* ViewTarget, UActorChannel* InChannel, float Time,
+                                             bool bLowBandwidth)
+{
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+
+	// Driven vehicles close to the viewer move fast on screen, they shouldn't wait behind parked ones
+	if (ECRVehicleReplication::bAdaptive && Controller
+		&& FVector::DistSquared(ViewPos, GetActorLocation()) < FMath::Square(NearViewerDistance))
+	{
+		Priority *= DrivenNearViewerPriorityScale;
+	}
+
+	return Priority;
+}
+
+bool AECRWheeledVehiclePawn::IsReplayRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation,
+                                                 const float CullDistance) const
+{
+	// Server replays keep players at the full rate, not only while another player sees them
+	return AECRGameMode::IsCriticalForReplay(this)
+		|| Super::IsReplayRelevantFor(RealViewer, ViewTarget, SrcLocation, CullDistance);
+}
+
+void AECRWheeledVehiclePawn::UpdateReplicationPolicy()
+{
+	if (!ECRVehicleReplication::bAdaptive)
+	{
+		NetUpdateFrequency = DrivenNearNetUpdateFrequency;
+		NetCullDistanceSquared = ActiveNetCullDistanceSquared;
+		if (NetDormancy > DORM_Awake)
+		{
+			SetNetDormancy(DORM_Awake);
+		}
+		ResumeAbilitySystem();
+		UpdateSimulationLOD(EECRVehicleSimulationLOD::Full);
+		return;
+	}
+
+	const bool bDriven = Controller != nullptr;
+	const bool bAtRest = GetVelocity().SizeSquared() <= FMath::Square(ParkedSpeed);
+	RestingTime = bDriven || !bAtRest ? 0.0f : RestingTime + ReplicationPolicyInterval;
+
+	if (bAtRest && !bDriven)
+	{
+		NetUpdateFrequency = ParkedNetUpdateFrequency;
+		NetCullDistanceSquared = ParkedNetCullDistanceSquared;
+		if (RestingTime >= DormancyDelay)
+		{
+			HibernateAbilitySystem();
+			UpdateSimulationLOD(EECRVehicleSimulationLOD::Asleep);
+			if (NetDormancy != DORM_DormantAll)
+			{
+				SetNetDormancy(DORM_DormantAll);
+			}
+		}
+		else
+		{
+			UpdateSimulationLOD(EECRVehicleSimulationLOD::Reduced);
+		}
+		return;
+	}
+
+	// Vehicles pushed or entered while dormant
+	if (NetDormancy > DORM_Awake)
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+	ResumeAbilitySystem();
+
+	NetCullDistanceSquared = ActiveNetCullDistanceSquared;
+	if (!bDriven)
+	{
+		NetUpdateFrequency = UnoccupiedNetUpdateFrequency;
+	}
+	else
+	{
+		NetUpdateFrequency = IsNearAnyViewer(NearViewerDistance) ? DrivenNearNetUpdateFrequency : DrivenNetUpdateFrequency;
+	}
+
+	UpdateSimulationLOD(bDriven || IsNearAnyViewer(FullSimulationDistance)
+		                    ? EECRVehicleSimulationLOD::Full
+		                    : EECRVehicleSimulationLOD::Reduced);
+}
+
+void AECRWheeledVehiclePawn::UpdateSimulationLOD(const EECRVehicleSimulationLOD DesiredLOD)
+{
+	if (!bSimulationLODLocked)
+	{
+		SetSimulationLOD(ECRVehicleReplication::bSimulationLOD ? DesiredLOD : EECRVehicleSimulationLOD::Full);
+	}
+}
+
+void AECRWheeledVehiclePawn::SetSimulationLOD(const EECRVehicleSimulationLOD NewLOD, const bool bLock)
+{
+	bSimulationLODLocked = bLock;
+	if (NewLOD == SimulationLOD)
+	{
+		return;
+	}
+
+	const EECRVehicleSimulationLOD OldLOD = SimulationLOD;
+	SimulationLOD = NewLOD;
+
+	// Shape and sphere sweeps are the most expensive part of suspension, raycasts are close enough on roads
+	// nobody looks at
+	if (UChaosWheeledVehicleMovementComponent* WheeledMovement =
+		Cast<UChaosWheeledVehicleMovementComponent>(GetVehicleMovementComponent()))
+	{
+		for (int32 WheelIndex = 0; WheelIndex < WheeledMovement->Wheels.Num(); ++WheelIndex)
+		{
+			UChaosVehicleWheel* Wheel = WheeledMovement->Wheels[WheelIndex];
+			if (Wheel && ConfiguredSweepShapes.IsValidIndex(WheelIndex))
+			{
+				Wheel->SweepShape = NewLOD == EECRVehicleSimulationLOD::Full
+					                    ? ConfiguredSweepShapes[WheelIndex]
+					                    : ESweepShape::Raycast;
+			}
+		}
+	}
+
+	if (NewLOD == EECRVehicleSimulationLOD::Asleep)
+	{
+		GetVehicleMovementComponent()->SetSleeping(true);
+	}
+	else if (OldLOD == EECRVehicleSimulationLOD::Asleep)
+	{
+		GetVehicleMovementComponent()->SetSleeping(false);
+	}
+}
+
+bool AECRWheeledVehiclePawn::IsNearAnyViewer(const float Distance) const
+{
+	const FVector Location = GetActorLocation();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController || PlayerController == Controller)
+		{
+			continue;
+		}
+
+		const AActor* ViewTarget = PlayerController->GetViewTarget();
+		if (ViewTarget && FVector::DistSquared(ViewTarget->GetActorLocation(), Location) < FMath::Square(Distance))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void AECRWheeledVehiclePawn::HibernateAbilitySystem()
+{
+	if (bAbilitySystemHibernating)
+	{
+		return;
+	}
+	bAbilitySystemHibernating = true;
+
+	// Only saves the tick, the ability system costs nothing else while the actor is dormant. Effects applied
+	// meanwhile are sent by FlushNetDormancy
+	AbilitySystemComponent->SetComponentTickEnabled(false);
+}
+
+void AECRWheeledVehiclePawn::ResumeAbilitySystem()
+{
+	if (!bAbilitySystemHibernating)
+	{
+		return;
+	}
+	bAbilitySystemHibernating = false;
+
+	AbilitySystemComponent->SetComponentTickEnabled(true);
+}
+
+void AECRWheeledVehiclePawn::HandleGameplayEffectExecuted(UAbilitySystemComponent* Source,
+                                                          const FGameplayEffectSpec& Spec,
+                                                          FActiveGameplayEffectHandle Handle)
+{
+	// Stay resumed for another delay, so a burning vehicle doesn't toggle every policy update
+	RestingTime = 0.0f;
+	ResumeAbilitySystem();
+
+	// Damage to a parked vehicle is sent once without waking it up
+	if (NetDormancy > DORM_Awake)
+	{
+		FlushNetDormancy();
+	}
+}
+
 void AECRWheeledVehiclePawn::OnAbilitySystemInitialized()
 {
 	UECRAbilitySystemComponent* ECRASC = GetECRAbilitySystemComponent();
@@ -146,6 +496,8 @@ void AECRWheeledVehiclePawn::PossessedBy(AController* NewController)
 	{
 		PawnExtComponent->SetPawnData(PawnData);
 	}
+
+	UpdateReplicationPolicy();
 }
 
 void AECRWheeledVehiclePawn::UnPossessed()
@@ -155,6 +507,11 @@ void AECRWheeledVehiclePawn::UnPossessed()
 	Super::UnPossessed();
 
 	PawnExtComponent->HandleControllerChanged();
+
+	if (HasAuthority())
+	{
+		UpdateReplicationPolicy();
+	}
 }
 
 void AECRWheeledVehiclePawn::OnRep_Controller()
@@ -4,6 +4,7 @@
 #include "Gameplay/Weapons/ECRRangedWeaponInstance.h"
 #include "Physics/ECRCollisionChannels.h"
 #include "System/ECRLogChannels.h"
+#include "System/ECRServerStatsSubsystem.h"
 #include "AIController.h"
 #include "System/Messages/ECRVerbMessage.h"
 #include "NativeGameplayTags.h"
@@ -567,6 +568,8 @@ void UECRGameplayAbility_RangedWeapon::EndAbility(const FGameplayAbilitySpecHand
 void UECRGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHandle& InData,
                                                                  FGameplayTag ApplicationTag)
 {
+	ECR_SERVER_STAT_SCOPE(RangedWeaponTargetData);
+
 	UAbilitySystemComponent* MyAbilityComponent = CurrentActorInfo->AbilitySystemComponent.Get();
 	check(MyAbilityComponent);
 
@@ -650,6 +653,8 @@ void UECRGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGameplay
 
 void UECRGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 {
+	ECR_SERVER_STAT_SCOPE(RangedWeaponTargeting);
+
 	check(CurrentActorInfo);
 
 	AActor* AvatarActor = CurrentActorInfo->AvatarActor.Get();
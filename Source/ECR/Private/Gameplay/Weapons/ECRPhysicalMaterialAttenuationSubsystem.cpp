@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Gameplay/Weapons/ECRPhysicalMaterialAttenuationSubsystem.h"
+
+#include "Engine/World.h"
+#include "Gameplay/Weapons/ECRRangedWeaponInstance.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "UObject/UObjectIterator.h"
+
+void UECRPhysicalMaterialAttenuationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+		this, &ThisClass::HandleLevelAddedToWorld);
+
+#if WITH_EDITOR
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(
+		this, &ThisClass::HandleObjectsReplaced);
+#endif
+}
+
+void UECRPhysicalMaterialAttenuationSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+
+	TablesByClass.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UECRPhysicalMaterialAttenuationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TSharedRef<const TMap<TObjectKey<UPhysicalMaterial>, float>> UECRPhysicalMaterialAttenuationSubsystem::GetTable(
+	const TSubclassOf<UECRRangedWeaponInstance> WeaponClass)
+{
+	check(WeaponClass);
+
+	if (const TSharedRef<TMap<TObjectKey<UPhysicalMaterial>, float>>* Table = TablesByClass.Find(WeaponClass.Get()))
+	{
+		return *Table;
+	}
+
+	TSharedRef<TMap<TObjectKey<UPhysicalMaterial>, float>> NewTable =
+		MakeShared<TMap<TObjectKey<UPhysicalMaterial>, float>>();
+	AddLoadedMaterials(GetDefault<UECRRangedWeaponInstance>(WeaponClass), *NewTable);
+	TablesByClass.Add(WeaponClass.Get(), NewTable);
+	return NewTable;
+}
+
+void UECRPhysicalMaterialAttenuationSubsystem::AddLoadedMaterials(const UECRRangedWeaponInstance* WeaponCDO,
+                                                                  TMap<TObjectKey<UPhysicalMaterial>, float>& Table)
+{
+	for (TObjectIterator<UPhysicalMaterial> It(RF_ClassDefaultObject); It; ++It)
+	{
+		if (!Table.Contains(*It))
+		{
+			Table.Add(*It, WeaponCDO->CalculatePhysicalMaterialAttenuation(*It));
+		}
+	}
+}
+
+void UECRPhysicalMaterialAttenuationSubsystem::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// Streamed levels bring their own materials, which would otherwise be matched on every hit
+	for (const TPair<TObjectKey<UClass>, TSharedRef<TMap<TObjectKey<UPhysicalMaterial>, float>>>& Pair :
+	     TablesByClass)
+	{
+		if (const UClass* WeaponClass = Pair.Key.ResolveObjectPtr())
+		{
+			AddLoadedMaterials(GetDefault<UECRRangedWeaponInstance>(WeaponClass), *Pair.Value);
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UECRPhysicalMaterialAttenuationSubsystem::HandleObjectsReplaced(const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+{
+	// Blueprints recompiled in place keep their class, so values baked from the old defaults can't be told apart.
+	// Weapons still holding an emptied table match tags until they are equipped again
+	for (const TPair<TObjectKey<UClass>, TSharedRef<TMap<TObjectKey<UPhysicalMaterial>, float>>>& Pair :
+	     TablesByClass)
+	{
+		Pair.Value->Reset();
+	}
+	TablesByClass.Reset();
+}
+#endif
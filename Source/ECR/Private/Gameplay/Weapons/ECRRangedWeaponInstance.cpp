@@ -10,11 +10,68 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Gameplay/ECRGameplayTags.h"
 #include "Gameplay/Camera/ECRCameraComponent.h"
+#include "Gameplay/Weapons/ECRPhysicalMaterialAttenuationSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "Physics/PhysicalMaterialWithTags.h"
+#include "Algo/BinarySearch.h"
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_ECR_Weapon_SteadyAimingCamera, "ECR.Weapon.SteadyAimingCamera");
 
+namespace ECRRangedWeaponInstance_Statics
+{
+	// Number of samples the heat curves are baked into
+	static constexpr int32 HeatLookupTableSize = 64;
+
+	// Cooldown time assigned to a heat segment whose cooldown rate is zero, the heat effectively stays there
+	static constexpr float StalledCooldownSegmentTime = 1.0e6f;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FECRHeatLookupTable
+
+void FECRHeatLookupTable::Reset(float InMinHeat, float InMaxHeat, int32 NumSamples)
+{
+	check(NumSamples > 0);
+	MinHeat = InMinHeat;
+	HeatStep = NumSamples > 1 ? (InMaxHeat - InMinHeat) / (NumSamples - 1) : 0.0f;
+	Values.SetNumZeroed(NumSamples);
+}
+
+float FECRHeatLookupTable::Eval(float Heat) const
+{
+	const int32 LastIndex = Values.Num() - 1;
+	if (LastIndex <= 0 || HeatStep <= 0.0f)
+	{
+		return Values.Num() > 0 ? Values[0] : 0.0f;
+	}
+
+	const float Position = FMath::Clamp((Heat - MinHeat) / HeatStep, 0.0f, static_cast<float>(LastIndex));
+	const int32 Index = FMath::Min(FMath::FloorToInt(Position), LastIndex - 1);
+	return FMath::Lerp(Values[Index], Values[Index + 1], Position - Index);
+}
+
+float FECRHeatLookupTable::FindHeatForValue(float Value) const
+{
+	const int32 LastIndex = Values.Num() - 1;
+	if (LastIndex <= 0 || Value <= Values[0])
+	{
+		return MinHeat;
+	}
+
+	if (Value >= Values[LastIndex])
+	{
+		return MinHeat + LastIndex * HeatStep;
+	}
+
+	const int32 Index = Algo::UpperBound(Values, Value) - 1;
+	const float SegmentRange = Values[Index + 1] - Values[Index];
+	const float Alpha = SegmentRange > 0.0f ? (Value - Values[Index]) / SegmentRange : 0.0f;
+	return MinHeat + (Index + Alpha) * HeatStep;
+}
+
+//////////////////////////////////////////////////////////////////////
+// UECRRangedWeaponInstance
+
 UECRRangedWeaponInstance::UECRRangedWeaponInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -22,10 +79,19 @@ UECRRangedWeaponInstance::UECRRangedWeaponInstance(const FObjectInitializer& Obj
 	HeatToCoolDownPerSecondCurve.EditorCurveData.AddKey(0.0f, 2.0f);
 }
 
+void UECRRangedWeaponInstance::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	BakeHeatCurves();
+}
+
 void UECRRangedWeaponInstance::PostLoad()
 {
 	Super::PostLoad();
 
+	BakeHeatCurves();
+
 #if WITH_EDITOR
 	UpdateDebugVisualization();
 #endif
@@ -35,6 +101,7 @@ void UECRRangedWeaponInstance::PostLoad()
 void UECRRangedWeaponInstance::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	BakeHeatCurves();
 	UpdateDebugVisualization();
 }
 
@@ -42,34 +109,74 @@ void UECRRangedWeaponInstance::UpdateDebugVisualization()
 {
 	ComputeHeatRange(/*out*/ Debug_MinHeat, /*out*/ Debug_MaxHeat);
 	ComputeSpreadRange(/*out*/ Debug_MinSpreadAngle, /*out*/ Debug_MaxSpreadAngle);
-	Debug_CurrentHeat = CurrentHeat;
-	Debug_CurrentSpreadAngle = CurrentSpreadAngle;
+	Debug_CurrentHeat = GetCurrentHeat();
+	Debug_CurrentSpreadAngle = GetCalculatedSpreadAngle();
 	Debug_CurrentSpreadAngleMultiplier = CurrentSpreadAngleMultiplier;
 }
 #endif
 
+void UECRRangedWeaponInstance::BakeHeatCurves()
+{
+	using namespace ECRRangedWeaponInstance_Statics;
+
+	ComputeHeatRange(/*out*/ MinHeatRange, /*out*/ MaxHeatRange);
+	ComputeSpreadRange(/*out*/ MinSpreadRange, /*out*/ MaxSpreadRange);
+
+	const int32 NumSamples = MaxHeatRange > MinHeatRange ? HeatLookupTableSize : 1;
+	SpreadByHeat.Reset(MinHeatRange, MaxHeatRange, NumSamples);
+	HeatPerShotByHeat.Reset(MinHeatRange, MaxHeatRange, NumSamples);
+	CooldownTimeByHeat.Reset(MinHeatRange, MaxHeatRange, NumSamples);
+
+	const FRichCurve* SpreadCurve = HeatToSpreadCurve.GetRichCurveConst();
+	const FRichCurve* HeatPerShotCurve = HeatToHeatPerShotCurve.GetRichCurveConst();
+	const FRichCurve* CooldownCurve = HeatToCoolDownPerSecondCurve.GetRichCurveConst();
+
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const float Heat = MinHeatRange + Index * SpreadByHeat.HeatStep;
+		SpreadByHeat.Values[Index] = SpreadCurve->Eval(Heat);
+		HeatPerShotByHeat.Values[Index] = HeatPerShotCurve->Eval(Heat);
+
+		// Integrate the time it takes to cool down through each heat segment
+		if (Index > 0)
+		{
+			const float CooldownRate = CooldownCurve->Eval(Heat - 0.5f * CooldownTimeByHeat.HeatStep);
+			const float SegmentTime = CooldownRate > KINDA_SMALL_NUMBER
+				                          ? CooldownTimeByHeat.HeatStep / CooldownRate
+				                          : StalledCooldownSegmentTime;
+			CooldownTimeByHeat.Values[Index] = CooldownTimeByHeat.Values[Index - 1] + SegmentTime;
+		}
+	}
+}
+
 void UECRRangedWeaponInstance::OnEquipped()
 {
 	Super::OnEquipped();
 
 	// Start heat in the start
-	float MinHeatRange;
-	float MaxHeatRange;
-	ComputeHeatRange(/*out*/ MinHeatRange, /*out*/ MaxHeatRange);
 	CurrentHeat = 0;
-
-	// Derive spread
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	HeatCooldownStartTime = GetWorld()->GetTimeSeconds();
 
 	// Default the multipliers to 1x
 	CurrentSpreadAngleMultiplier = 1.0f;
 	StandingStillMultiplier = 1.0f;
 	JumpFallMultiplier = 1.0f;
 	CrouchingMultiplier = 1.0f;
+	bMultipliersDirty = true;
+
+	// Damage is only calculated with authority
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		BakePhysicalMaterialAttenuation();
+	}
+
+	BindToAbilitySystemTags();
 }
 
 void UECRRangedWeaponInstance::OnUnequipped()
 {
+	UnbindFromAbilitySystemTags();
+
 	Super::OnUnequipped();
 }
 
@@ -78,10 +185,13 @@ void UECRRangedWeaponInstance::Tick(float DeltaSeconds)
 	APawn* Pawn = GetPawn();
 	check(Pawn != nullptr);
 
-	const bool bMinSpread = UpdateSpread(DeltaSeconds);
-	const bool bMinMultipliers = UpdateMultipliers(DeltaSeconds);
+	// The ability system may not have been available yet when equipped
+	if (!BoundAbilitySystem.IsValid())
+	{
+		BindToAbilitySystemTags();
+	}
 
-	bHasFirstShotAccuracy = bAllowFirstShotAccuracy && bMinMultipliers && bMinSpread;
+	bMultipliersAtMin = UpdateMultipliers(DeltaSeconds);
 
 #if WITH_EDITOR
 	UpdateDebugVisualization();
@@ -111,31 +221,69 @@ void UECRRangedWeaponInstance::ComputeSpreadRange(float& MinSpread, float& MaxSp
 	HeatToSpreadCurve.GetRichCurveConst()->GetValueRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 }
 
-void UECRRangedWeaponInstance::AddSpread()
+float UECRRangedWeaponInstance::GetHeatAtTime(double WorldTime) const
 {
-	// Sample the heat up curve
-	const float HeatPerShot = HeatToHeatPerShotCurve.GetRichCurveConst()->Eval(CurrentHeat);
-	CurrentHeat = ClampHeat(CurrentHeat + HeatPerShot);
+	const double CooldownSeconds = WorldTime - HeatCooldownStartTime;
+	if (CooldownSeconds <= 0.0)
+	{
+		return CurrentHeat;
+	}
 
-	// Map the heat to the spread angle
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	// Walk the integrated cooldown time back from the current heat instead of stepping the cooldown curve per frame
+	const double RemainingCooldownTime = CooldownTimeByHeat.Eval(CurrentHeat) - CooldownSeconds;
+	return RemainingCooldownTime > 0.0 ? CooldownTimeByHeat.FindHeatForValue(RemainingCooldownTime) : MinHeatRange;
+}
 
-#if WITH_EDITOR
-	UpdateDebugVisualization();
-#endif
+float UECRRangedWeaponInstance::GetCurrentHeat() const
+{
+	const UWorld* World = GetWorld();
+	return World ? GetHeatAtTime(World->GetTimeSeconds()) : CurrentHeat;
 }
 
-void UECRRangedWeaponInstance::RemoveHeat(float DeltaHeat)
+float UECRRangedWeaponInstance::GetCalculatedSpreadAngle() const
+{
+	return SpreadByHeat.Eval(GetCurrentHeat());
+}
+
+bool UECRRangedWeaponInstance::HasFirstShotAccuracy() const
+{
+	return bAllowFirstShotAccuracy && bMultipliersAtMin
+		&& FMath::IsNearlyEqual(GetCalculatedSpreadAngle(), MinSpreadRange, KINDA_SMALL_NUMBER);
+}
+
+void UECRRangedWeaponInstance::SetHeat(float NewHeat, float CooldownDelay)
 {
-	CurrentHeat = ClampHeat(CurrentHeat - DeltaHeat);
-	// Map the heat to the spread angle
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentHeat = ClampHeat(NewHeat);
+	++HeatRevision;
+	HeatCooldownStartTime = GetWorld()->GetTimeSeconds() + CooldownDelay;
 
 #if WITH_EDITOR
 	UpdateDebugVisualization();
 #endif
 }
 
+void UECRRangedWeaponInstance::OnRep_CurrentHeat()
+{
+	// Cool down from the replicated heat, respecting the recovery delay of our own last shot
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+	HeatCooldownStartTime = FMath::Max(WorldTime, TimeLastFired + SpreadRecoveryCooldownDelay);
+}
+
+void UECRRangedWeaponInstance::AddSpread()
+{
+	// Sample the heat up curve
+	const float Heat = GetCurrentHeat();
+	const float HeatPerShot = HeatPerShotByHeat.Eval(Heat);
+	SetHeat(Heat + HeatPerShot, SpreadRecoveryCooldownDelay);
+}
+
+void UECRRangedWeaponInstance::RemoveHeat(float DeltaHeat)
+{
+	// Keep whatever is left of the recovery delay
+	const double RemainingDelay = FMath::Max(0.0, HeatCooldownStartTime - GetWorld()->GetTimeSeconds());
+	SetHeat(GetCurrentHeat() - DeltaHeat, RemainingDelay);
+}
+
 float UECRRangedWeaponInstance::GetDistanceAttenuation(float Distance, const FGameplayTagContainer* SourceTags,
                                                        const FGameplayTagContainer* TargetTags) const
 {
@@ -146,6 +294,41 @@ float UECRRangedWeaponInstance::GetDistanceAttenuation(float Distance, const FGa
 float UECRRangedWeaponInstance::GetPhysicalMaterialAttenuation(const UPhysicalMaterial* PhysicalMaterial,
                                                                const FGameplayTagContainer* SourceTags,
                                                                const FGameplayTagContainer* TargetTags) const
+{
+	if (!PhysicalMaterial || MaterialDamageMultiplier.IsEmpty())
+	{
+		return 1.0f;
+	}
+
+	if (PhysicalMaterialAttenuationTable.IsValid())
+	{
+		if (const float* pAttenuation = PhysicalMaterialAttenuationTable->Find(PhysicalMaterial))
+		{
+			return *pAttenuation;
+		}
+	}
+
+	// Material loaded after the table was baked, matched without touching the shared table
+	return CalculatePhysicalMaterialAttenuation(PhysicalMaterial);
+}
+
+void UECRRangedWeaponInstance::BakePhysicalMaterialAttenuation()
+{
+	PhysicalMaterialAttenuationTable.Reset();
+
+	if (MaterialDamageMultiplier.IsEmpty())
+	{
+		return;
+	}
+
+	if (UECRPhysicalMaterialAttenuationSubsystem* AttenuationSubsystem =
+		GetWorld()->GetSubsystem<UECRPhysicalMaterialAttenuationSubsystem>())
+	{
+		PhysicalMaterialAttenuationTable = AttenuationSubsystem->GetTable(GetClass());
+	}
+}
+
+float UECRRangedWeaponInstance::CalculatePhysicalMaterialAttenuation(const UPhysicalMaterial* PhysicalMaterial) const
 {
 	float CombinedMultiplier = 1.0f;
 	if (const UPhysicalMaterialWithTags* PhysMatWithTags = Cast<const UPhysicalMaterialWithTags>(PhysicalMaterial))
@@ -167,30 +350,7 @@ void UECRRangedWeaponInstance::GetLifetimeReplicatedProps(TArray<FLifetimeProper
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(ThisClass, CurrentHeat);
-}
-
-bool UECRRangedWeaponInstance::UpdateSpread(float DeltaSeconds)
-{
-	const float TimeSinceFired = GetWorld()->TimeSince(TimeLastFired);
-
-	if (TimeSinceFired > SpreadRecoveryCooldownDelay)
-	{
-		const float CooldownRate = HeatToCoolDownPerSecondCurve.GetRichCurveConst()->Eval(CurrentHeat);
-
-		// Update heat only on server
-		if (GetWorld()->GetNetMode() < NM_Client)
-		{
-			CurrentHeat = ClampHeat(CurrentHeat - (CooldownRate * DeltaSeconds));
-		}
-
-		CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
-	}
-
-	float MinSpread;
-	float MaxSpread;
-	ComputeSpreadRange(/*out*/ MinSpread, /*out*/ MaxSpread);
-
-	return FMath::IsNearlyEqual(CurrentSpreadAngle, MinSpread, KINDA_SMALL_NUMBER);
+	DOREPLIFETIME(ThisClass, HeatRevision);
 }
 
 bool UECRRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
@@ -201,44 +361,48 @@ bool UECRRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 	check(Pawn != nullptr);
 	UCharacterMovementComponent* CharMovementComp = Cast<UCharacterMovementComponent>(Pawn->GetMovementComponent());
 
-	// See if we are standing still, and if so, smoothly apply the bonus
+	// See if we are standing still, crouching or in the air (jumping/falling)
 	const float PawnSpeed = Pawn->GetVelocity().Size();
 	const float MovementTargetValue = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(StandingStillSpeedThreshold,
 		                          StandingStillSpeedThreshold + StandingStillToMovingSpeedRange),
 		                /*OutputRange=*/ FVector2D(SpreadAngleMultiplier_StandingStill, 1.0f),
 		                /*Alpha=*/ PawnSpeed);
+	const bool bIsCrouching = (CharMovementComp != nullptr) && CharMovementComp->IsCrouching();
+	const float CrouchingTargetValue = bIsCrouching ? SpreadAngleMultiplier_Crouching : 1.0f;
+	const bool bIsJumpingOrFalling = (CharMovementComp != nullptr) && CharMovementComp->IsFalling();
+	const float JumpFallTargetValue = bIsJumpingOrFalling ? SpreadAngleMultiplier_JumpingOrFalling : 1.0f;
+
+	// Everything already settled on its target and no tag changed, the combined multiplier is up to date
+	if (!bMultipliersDirty
+		&& StandingStillMultiplier == MovementTargetValue
+		&& CrouchingMultiplier == CrouchingTargetValue
+		&& JumpFallMultiplier == JumpFallTargetValue)
+	{
+		return bMultipliersAtMin;
+	}
+	bMultipliersDirty = false;
+
+	// Smoothly apply the standing still bonus
 	StandingStillMultiplier = FMath::FInterpTo(StandingStillMultiplier, MovementTargetValue, DeltaSeconds,
 	                                           TransitionRate_StandingStill);
 	const bool bStandingStillMultiplierAtMin = FMath::IsNearlyEqual(StandingStillMultiplier,
 	                                                                SpreadAngleMultiplier_StandingStill,
 	                                                                SpreadAngleMultiplier_StandingStill * 0.1f);
 
-	// See if we are crouching, and if so, smoothly apply the bonus
-	const bool bIsCrouching = (CharMovementComp != nullptr) && CharMovementComp->IsCrouching();
-	const float CrouchingTargetValue = bIsCrouching ? SpreadAngleMultiplier_Crouching : 1.0f;
+	// Smoothly apply the crouching bonus
 	CrouchingMultiplier = FMath::FInterpTo(CrouchingMultiplier, CrouchingTargetValue, DeltaSeconds,
 	                                       TransitionRate_Crouching);
 	const bool bCrouchingMultiplierAtTarget = FMath::IsNearlyEqual(CrouchingMultiplier, CrouchingTargetValue,
 	                                                               MultiplierNearlyEqualThreshold);
 
-	// See if we are in the air (jumping/falling), and if so, smoothly apply the penalty
-	const bool bIsJumpingOrFalling = (CharMovementComp != nullptr) && CharMovementComp->IsFalling();
-	const float JumpFallTargetValue = bIsJumpingOrFalling ? SpreadAngleMultiplier_JumpingOrFalling : 1.0f;
+	// Smoothly apply the jumping/falling penalty
 	JumpFallMultiplier = FMath::FInterpTo(JumpFallMultiplier, JumpFallTargetValue, DeltaSeconds,
 	                                      TransitionRate_JumpingOrFalling);
 	const bool bJumpFallMultiplerIs1 = FMath::IsNearlyEqual(JumpFallMultiplier, 1.0f, MultiplierNearlyEqualThreshold);
 
-	// Determine if we are aiming down sights, and apply the bonus based on how far into the camera transition we are
-	float AimingAlpha = 0.0f;
-	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn))
-	{
-		if (ASC->HasMatchingGameplayTag(FECRGameplayTags::Get().Status_ADS))
-		{
-			AimingAlpha = 1.0f;
-		}
-	}
-
+	// Apply the aiming down sights bonus, the state is kept up to date by OnAimingTagChanged
+	const float AimingAlpha = bIsAiming ? 1.0f : 0.0f;
 	const float AimingMultiplier = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(0.0f, 1.0f),
 		                /*OutputRange=*/ FVector2D(1.0f, SpreadAngleMultiplier_Aiming),
@@ -246,16 +410,8 @@ bool UECRRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 	const bool bAimingMultiplierAtTarget = FMath::IsNearlyEqual(AimingMultiplier, SpreadAngleMultiplier_Aiming,
 	                                                            KINDA_SMALL_NUMBER);
 
-	// Determine if we are bracing
-	float BracingAlpha = 0.0f;
-	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn))
-	{
-		if (ASC->HasMatchingGameplayTag(FECRGameplayTags::Get().Status_Bracing))
-		{
-			BracingAlpha = 1.0f;
-		}
-	}
-	
+	// Apply the bracing bonus, the state is kept up to date by OnBracingTagChanged
+	const float BracingAlpha = bIsBracing ? 1.0f : 0.0f;
 	const float BracingMultiplier = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(0.0f, 1.0f),
 						/*OutputRange=*/ FVector2D(1.0f, SpreadAngleMultiplier_Bracing),
@@ -272,3 +428,56 @@ bool UECRRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 	return bStandingStillMultiplierAtMin && bCrouchingMultiplierAtTarget && bJumpFallMultiplerIs1 &&
 		bAimingMultiplierAtTarget && bBracingAlphaMultiplierAtTarget;
 }
+
+void UECRRangedWeaponInstance::BindToAbilitySystemTags()
+{
+	UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetPawn());
+	if (!ASC || ASC == BoundAbilitySystem.Get())
+	{
+		return;
+	}
+
+	UnbindFromAbilitySystemTags();
+
+	const FECRGameplayTags& GameplayTags = FECRGameplayTags::Get();
+	AimingTagChangedHandle = ASC->RegisterGameplayTagEvent(GameplayTags.Status_ADS, EGameplayTagEventType::NewOrRemoved)
+	                            .AddUObject(this, &ThisClass::OnAimingTagChanged);
+	BracingTagChangedHandle = ASC->RegisterGameplayTagEvent(GameplayTags.Status_Bracing,
+	                                                        EGameplayTagEventType::NewOrRemoved)
+	                             .AddUObject(this, &ThisClass::OnBracingTagChanged);
+	BoundAbilitySystem = ASC;
+
+	bIsAiming = ASC->HasMatchingGameplayTag(GameplayTags.Status_ADS);
+	bIsBracing = ASC->HasMatchingGameplayTag(GameplayTags.Status_Bracing);
+	bMultipliersDirty = true;
+}
+
+void UECRRangedWeaponInstance::UnbindFromAbilitySystemTags()
+{
+	if (UAbilitySystemComponent* ASC = BoundAbilitySystem.Get())
+	{
+		const FECRGameplayTags& GameplayTags = FECRGameplayTags::Get();
+		ASC->UnregisterGameplayTagEvent(AimingTagChangedHandle, GameplayTags.Status_ADS,
+		                                EGameplayTagEventType::NewOrRemoved);
+		ASC->UnregisterGameplayTagEvent(BracingTagChangedHandle, GameplayTags.Status_Bracing,
+		                                EGameplayTagEventType::NewOrRemoved);
+	}
+
+	BoundAbilitySystem.Reset();
+	AimingTagChangedHandle.Reset();
+	BracingTagChangedHandle.Reset();
+	bIsAiming = false;
+	bIsBracing = false;
+}
+
+void UECRRangedWeaponInstance::OnAimingTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	bIsAiming = NewCount > 0;
+	bMultipliersDirty = true;
+}
+
+void UECRRangedWeaponInstance::OnBracingTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	bIsBracing = NewCount > 0;
+	bMultipliersDirty = true;
+}
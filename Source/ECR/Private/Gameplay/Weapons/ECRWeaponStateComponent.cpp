@@ -5,7 +5,6 @@
 #include "GameFramework/PlayerController.h"
 #include "Abilities/GameplayAbilityTargetTypes.h"
 #include "AbilitySystemComponent.h"
-#include "Kismet/GameplayStatics.h"
 
 #include "GameFramework/Pawn.h"
 #include "Gameplay/Equipment/ECREquipmentManagerComponent.h"
@@ -15,6 +14,15 @@
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Gameplay_Zone, "Gameplay.Zone");
 
+namespace ECRWeaponStateComponent_Statics
+{
+	// Time (in seconds) after which a hit marker batch the server did not confirm is dropped
+	static constexpr double UnconfirmedHitMarkerLifetime = 2.0;
+
+	// Time (in seconds) between checks for expired hit marker batches
+	static constexpr double UnconfirmedHitMarkerExpiryCheckInterval = 0.5;
+}
+
 UECRWeaponStateComponent::UECRWeaponStateComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -29,54 +37,57 @@ void UECRWeaponStateComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (APawn* Pawn = GetPawn<APawn>())
+	if (UECREquipmentManagerComponent* EquipmentManager = GetPawnEquipmentManager())
 	{
-		if (UECREquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<
-			UECREquipmentManagerComponent>())
+		if (UECRRangedWeaponInstance* CurrentWeapon = EquipmentManager->GetFirstInstanceOfType<
+			UECRRangedWeaponInstance>())
 		{
-			if (UECRRangedWeaponInstance* CurrentWeapon = Cast<UECRRangedWeaponInstance>(
-				EquipmentManager->GetFirstInstanceOfType(UECRRangedWeaponInstance::StaticClass())))
-			{
-				CurrentWeapon->Tick(DeltaTime);
-			}
+			CurrentWeapon->Tick(DeltaTime);
 		}
 	}
 }
 
+UECREquipmentManagerComponent* UECRWeaponStateComponent::GetPawnEquipmentManager()
+{
+	APawn* Pawn = GetPawn<APawn>();
+	if (Pawn != CachedPawn.Get())
+	{
+		CachedPawn = Pawn;
+		CachedEquipmentManager = Pawn ? Pawn->FindComponentByClass<UECREquipmentManagerComponent>() : nullptr;
+	}
+
+	return CachedEquipmentManager.Get();
+}
+
 void UECRWeaponStateComponent::ClientConfirmTargetData_Implementation(uint16 UniqueId, bool bSuccess,
                                                                       const TArray<uint8>& HitReplaces)
 {
-	for (int i = 0; i < UnconfirmedServerSideHitMarkers.Num(); i++)
+	FECRServerSideHitMarkerBatch Batch;
+	if (!UnconfirmedServerSideHitMarkers.RemoveAndCopyValue(UniqueId, Batch))
 	{
-		FECRServerSideHitMarkerBatch& Batch = UnconfirmedServerSideHitMarkers[i];
-		if (Batch.UniqueId == UniqueId)
+		return;
+	}
+
+	if (bSuccess && (HitReplaces.Num() != Batch.Markers.Num()))
+	{
+		bool bFoundShowAsSuccessHit = false;
+
+		int32 HitLocationIndex = 0;
+		for (const FECRScreenSpaceHitLocation& Entry : Batch.Markers)
 		{
-			if (bSuccess && (HitReplaces.Num() != Batch.Markers.Num()))
+			if (!HitReplaces.Contains(HitLocationIndex) && Entry.HitSuccess)
 			{
-				UWorld* World = GetWorld();
-				bool bFoundShowAsSuccessHit = false;
-
-				int32 HitLocationIndex = 0;
-				for (const FECRScreenSpaceHitLocation& Entry : Batch.Markers)
+				// Only need to do this once
+				if (!bFoundShowAsSuccessHit)
 				{
-					if (!HitReplaces.Contains(HitLocationIndex) && Entry.HitSuccess)
-					{
-						// Only need to do this once
-						if (!bFoundShowAsSuccessHit)
-						{
-							ActuallyUpdateDamageInstigatedTime();
-						}
-
-						bFoundShowAsSuccessHit = true;
-
-						LastWeaponDamageScreenLocations.Add(Entry);
-					}
-					++HitLocationIndex;
+					ActuallyUpdateDamageInstigatedTime();
 				}
-			}
 
-			UnconfirmedServerSideHitMarkers.RemoveAt(i);
-			break;
+				bFoundShowAsSuccessHit = true;
+
+				LastWeaponDamageLocations.Add(Entry);
+			}
+			++HitLocationIndex;
 		}
 	}
 }
@@ -85,39 +96,61 @@ void UECRWeaponStateComponent::AddUnconfirmedServerSideHitMarkers(const UObject*
                                                                   const FGameplayAbilityTargetDataHandle& InTargetData,
                                                                   const TArray<FHitResult>& FoundHits)
 {
-	FECRServerSideHitMarkerBatch& NewUnconfirmedHitMarker = UnconfirmedServerSideHitMarkers.Emplace_GetRef(
+	// Only players look at hit markers
+	if (GetController<APlayerController>() == nullptr)
+	{
+		return;
+	}
+
+	RemoveExpiredUnconfirmedHitMarkers();
+
+	// Unique ids wrap around, a batch still waiting under the same id is stale and gets replaced
+	FECRServerSideHitMarkerBatch& NewUnconfirmedHitMarker = UnconfirmedServerSideHitMarkers.Add(
 		InTargetData.UniqueId);
+	NewUnconfirmedHitMarker.CreationTime = GetWorld()->GetTimeSeconds();
+	NewUnconfirmedHitMarker.Markers.Reserve(FoundHits.Num());
 
-	if (APlayerController* OwnerPC = GetController<APlayerController>())
+	// Markers are projected to the screen by the HUD when it draws them
+	for (const FHitResult& Hit : FoundHits)
 	{
-		for (const FHitResult& Hit : FoundHits)
+		FECRScreenSpaceHitLocation& Entry = NewUnconfirmedHitMarker.Markers.AddDefaulted_GetRef();
+		Entry.WorldLocation = Hit.Location;
+		Entry.HitSuccess = ShouldShowHitAsSuccess(SourceObject, Hit);
+
+		// Determine the hit zone
+		if (const UPhysicalMaterialWithTags* PhysMatWithTags = Cast<const UPhysicalMaterialWithTags>(
+			Hit.PhysMaterial.Get()))
 		{
-			FVector2D HitScreenLocation;
-			if (UGameplayStatics::ProjectWorldToScreen(OwnerPC, Hit.Location, /*out*/ HitScreenLocation,
-			                                           /*bPlayerViewportRelative=*/ false))
+			for (const FGameplayTag MaterialTag : PhysMatWithTags->Tags)
 			{
-				FECRScreenSpaceHitLocation& Entry = NewUnconfirmedHitMarker.Markers.AddDefaulted_GetRef();
-				Entry.Location = HitScreenLocation;
-				Entry.HitSuccess = ShouldShowHitAsSuccess(SourceObject, Hit);
-
-				// Determine the hit zone
-				if (const UPhysicalMaterialWithTags* PhysMatWithTags = Cast<const UPhysicalMaterialWithTags>(
-					Hit.PhysMaterial.Get()))
+				if (MaterialTag.MatchesTag(TAG_Gameplay_Zone))
 				{
-					for (const FGameplayTag MaterialTag : PhysMatWithTags->Tags)
-					{
-						if (MaterialTag.MatchesTag(TAG_Gameplay_Zone))
-						{
-							Entry.HitZone = MaterialTag;
-							break;
-						}
-					}
+					Entry.HitZone = MaterialTag;
+					break;
 				}
 			}
 		}
 	}
 }
 
+void UECRWeaponStateComponent::RemoveExpiredUnconfirmedHitMarkers()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	if (CurrentTime < NextUnconfirmedHitMarkerExpiryCheckTime)
+	{
+		return;
+	}
+	NextUnconfirmedHitMarkerExpiryCheckTime = CurrentTime + ECRWeaponStateComponent_Statics::UnconfirmedHitMarkerExpiryCheckInterval;
+
+	for (auto It = UnconfirmedServerSideHitMarkers.CreateIterator(); It; ++It)
+	{
+		if (CurrentTime - It.Value().CreationTime > ECRWeaponStateComponent_Statics::UnconfirmedHitMarkerLifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
 void UECRWeaponStateComponent::UpdateDamageInstigatedTime(const FGameplayEffectContextHandle& EffectContext)
 {
 	if (ShouldUpdateDamageInstigatedTime(EffectContext))
@@ -134,11 +167,11 @@ bool UECRWeaponStateComponent::ShouldUpdateDamageInstigatedTime_Implementation(
 
 void UECRWeaponStateComponent::ActuallyUpdateDamageInstigatedTime()
 {
-	// If our LastWeaponDamageInstigatedTime was not very recent, clear our LastWeaponDamageScreenLocations array
+	// If our LastWeaponDamageInstigatedTime was not very recent, clear our LastWeaponDamageLocations array
 	UWorld* World = GetWorld();
 	if (World->GetTimeSeconds() - LastWeaponDamageInstigatedTime > 0.1)
 	{
-		LastWeaponDamageScreenLocations.Reset();
+		LastWeaponDamageLocations.Reset();
 	}
 	LastWeaponDamageInstigatedTime = World->GetTimeSeconds();
 }
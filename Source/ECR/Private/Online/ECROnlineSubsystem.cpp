@@ -3,44 +3,224 @@
 
 #include "Online/ECROnlineSubsystem.h"
 #include "System/MatchSettings.h"
+#include "OnlineSessionSettings.h"
+#include "Misc/Base64.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 
 FECRMatchResult::FECRMatchResult()
 {
 	CurrentPlayerAmount = 0;
+	MaxPlayerAmount = 0;
 	MatchStartedTimestamp = 0.0f;
+	bIsValid = false;
 }
 
 
-FECRMatchResult::FECRMatchResult(const FBlueprintSessionResult BlueprintSessionIn)
+namespace ECRMatchAdvertisement
 {
-	BlueprintSession = BlueprintSessionIn;
+	/** Packed data is a single base64 session attribute, EOS limits attribute strings to 1000 characters */
+	constexpr int32 MaxEncodedMatchDataLength = 1000;
+
+	void SerializeMatchData(FArchive& Ar, FECRMatchAdvertisement& Data)
+	{
+		Ar << Data.WeatherName;
+		Ar << Data.DayTimeName;
+		Ar << Data.UserDisplayName;
+
+		uint8 NumAlliances = Data.Alliances.Num();
+		Ar << NumAlliances;
+		Data.Alliances.SetNum(NumAlliances);
+
+		for (FFactionAlliance& Alliance : Data.Alliances)
+		{
+			Ar << Alliance.Strength;
+
+			uint8 NumFactions = Alliance.FactionNames.Num();
+			Ar << NumFactions;
+			Alliance.FactionNames.SetNum(NumFactions);
+
+			for (FName& FactionName : Alliance.FactionNames)
+			{
+				Ar << FactionName;
+
+				FString ShortText;
+				if (Ar.IsSaving())
+				{
+					if (const FText* FactionShortText = Data.FactionNamesToShortTexts.Find(FactionName))
+					{
+						ShortText = FactionShortText->ToString();
+					}
+				}
+				Ar << ShortText;
+				if (Ar.IsLoading())
+				{
+					Data.FactionNamesToShortTexts.Add(FactionName, FText::FromString(ShortText));
+				}
+			}
+		}
+
+		Ar << Data.CurrentPlayerAmount;
+		Ar << Data.MatchStartedTime;
+	}
+}
 
-	// Retrieving match data into this struct
-	FString StringBuffer;
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_MAPNAME, StringBuffer);
-	Map = FName{*StringBuffer};
+void FECRMatchAdvertisement::Write(FOnlineSessionSettings& SessionSettings) const
+{
+	SessionSettings.Set(SETTING_GAMEMODE, GameMode.ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+	SessionSettings.Set(SETTING_MAPNAME, MapName.ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+	SessionSettings.Set(SETTING_GAME_MISSION, GameMission.ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+	SessionSettings.Set(SETTING_REGION, Region.ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+	SessionSettings.Set(SETTING_GAME_VERSION, GameVersion, EOnlineDataAdvertisementType::ViaOnlineService);
+
+	// For some reason getting int in EOS doesn't work, so schema version is compared as a string
+	SessionSettings.Set(SETTING_MATCH_SCHEMA, FString::FromInt(SchemaVersion),
+	                    EOnlineDataAdvertisementType::ViaOnlineService);
+
+	// Set boolean flags for filtering by participating factions
+	for (const FFactionAlliance& Alliance : Alliances)
+	{
+		for (const FName& FactionName : Alliance.FactionNames)
+		{
+			SessionSettings.Set(FName{SETTING_FACTION_PREFIX.ToString() + FactionName.ToString()}, true,
+			                    EOnlineDataAdvertisementType::ViaOnlineService);
+		}
+	}
+
+	TArray<uint8> MatchData;
+	FMemoryWriter Writer(MatchData);
+
+	uint8 Version = SchemaVersion;
+	Writer << Version;
+	FECRMatchAdvertisement Data = *this;
+	ECRMatchAdvertisement::SerializeMatchData(Writer, Data);
+
+	const FString EncodedMatchData = FBase64::Encode(MatchData);
+	ensureMsgf(EncodedMatchData.Len() <= ECRMatchAdvertisement::MaxEncodedMatchDataLength,
+	           TEXT("Encoded match data is %d characters, online services may reject it"), EncodedMatchData.Len());
+
+	SessionSettings.Set(SETTING_MATCH_DATA, EncodedMatchData, EOnlineDataAdvertisementType::ViaOnlineService);
+}
+
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_GAME_MISSION, StringBuffer);
-	Mission = FName{*StringBuffer};
+bool FECRMatchAdvertisement::Read(const FOnlineSessionSettings& SessionSettings)
+{
+	FString EncodedMatchData;
+	if (!SessionSettings.Get(SETTING_MATCH_DATA, EncodedMatchData)
+		|| EncodedMatchData.Len() > ECRMatchAdvertisement::MaxEncodedMatchDataLength)
+	{
+		return false;
+	}
+
+	TArray<uint8> MatchData;
+	if (!FBase64::Decode(EncodedMatchData, MatchData))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(MatchData);
+
+	uint8 Version = 0;
+	Reader << Version;
+	if (Version != SchemaVersion)
+	{
+		return false;
+	}
+
+	Alliances.Reset();
+	FactionNamesToShortTexts.Reset();
+	ECRMatchAdvertisement::SerializeMatchData(Reader, *this);
+	if (Reader.IsError() || !Reader.AtEnd())
+	{
+		return false;
+	}
+
+	FString StringBuffer;
+	SessionSettings.Get(SETTING_GAMEMODE, StringBuffer);
+	GameMode = FName{*StringBuffer};
+
+	StringBuffer.Reset();
+	SessionSettings.Get(SETTING_MAPNAME, StringBuffer);
+	MapName = FName{*StringBuffer};
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_GAMEMODE, StringBuffer);
-	Mode = FName{*StringBuffer};
+	StringBuffer.Reset();
+	SessionSettings.Get(SETTING_GAME_MISSION, StringBuffer);
+	GameMission = FName{*StringBuffer};
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_REGION, StringBuffer);
+	StringBuffer.Reset();
+	SessionSettings.Get(SETTING_REGION, StringBuffer);
 	Region = FName{*StringBuffer};
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_WEATHER_NAME, StringBuffer);
-	Weather = FName{*StringBuffer};
+	SessionSettings.Get(SETTING_GAME_VERSION, GameVersion);
+
+	return true;
+}
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_DAYTIME_NAME, StringBuffer);
-	DayTime = FName{*StringBuffer};
 
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_CURRENT_PLAYER_AMOUNT, CurrentPlayerAmount);
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_STARTED_TIME, MatchStartedTimestamp);
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_FACTIONS, FactionsString);
-	BlueprintSession.OnlineResult.Session.SessionSettings.Get(SETTING_USER_DISPLAY_NAME, UserDisplayName);
+FString FECRMatchAdvertisement::GetFactionsString() const
+{
+	TArray<FString> Sides;
+	for (const FFactionAlliance& Alliance : Alliances)
+	{
+		TArray<FString> SideFactions;
+		for (const FName& FactionName : Alliance.FactionNames)
+		{
+			const FText* FactionShortNameText = FactionNamesToShortTexts.Find(FactionName);
+			SideFactions.Add(FactionShortNameText ? FactionShortNameText->ToString() : FactionName.ToString());
+		}
+		Sides.Add(FString::Join(SideFactions, TEXT(", ")));
+	}
+	return FString::Join(Sides, TEXT(" vs "));
+}
+
+
+void FECRMatchAdvertisement::AddSchemaQuery(FOnlineSessionSearch& Search)
+{
+	Search.QuerySettings.Set(SETTING_MATCH_SCHEMA, FString::FromInt(SchemaVersion), EOnlineComparisonOp::Equals);
+}
+
+
+FECRMatchResult::FECRMatchResult(const FBlueprintSessionResult BlueprintSessionIn)
+{
+	BlueprintSession = BlueprintSessionIn;
+	SessionId = BlueprintSession.OnlineResult.GetSessionIdStr();
+	MaxPlayerAmount = BlueprintSession.OnlineResult.Session.SessionSettings.NumPublicConnections;
+
+	// Retrieving match data into this struct
+	FECRMatchAdvertisement Advertisement;
+	bIsValid = Advertisement.Read(BlueprintSession.OnlineResult.Session.SessionSettings);
+
+	Map = Advertisement.MapName;
+	Mode = Advertisement.GameMode;
+	Mission = Advertisement.GameMission;
+	Region = Advertisement.Region;
+	Weather = Advertisement.WeatherName;
+	DayTime = Advertisement.DayTimeName;
+	CurrentPlayerAmount = Advertisement.CurrentPlayerAmount;
+	CurrentPlayerAmountString = FString::FromInt(CurrentPlayerAmount);
+	MatchStartedTimestamp = Advertisement.MatchStartedTime;
+	FactionsString = Advertisement.GetFactionsString();
+	UserDisplayName = Advertisement.UserDisplayName;
+}
+
+
+bool FECRMatchResult::UpdateDynamicSettings(const FOnlineSessionSearchResult& SearchResult)
+{
+	FECRMatchAdvertisement Advertisement;
+	if (!Advertisement.Read(SearchResult.Session.SessionSettings))
+	{
+		return false;
+	}
+
+	BlueprintSession.OnlineResult = SearchResult;
+	MaxPlayerAmount = SearchResult.Session.SessionSettings.NumPublicConnections;
+	DayTime = Advertisement.DayTimeName;
+	CurrentPlayerAmount = Advertisement.CurrentPlayerAmount;
+	CurrentPlayerAmountString = FString::FromInt(CurrentPlayerAmount);
+	MatchStartedTimestamp = Advertisement.MatchStartedTime;
+	return true;
 }
 
 
@@ -0,0 +1,155 @@
+// Copyleft: All rights reversed
+
+
+#include "Online/ECRQuickPlayScorer.h"
+#include "System/ECRLogChannels.h"
+#include "HAL/IConsoleManager.h"
+
+
+namespace ECRQuickPlay
+{
+	// Deterministic check of candidate ranking with the configured scorer weights on a synthetic session list. Run with
+	//   ECR.QuickPlay.TestRanking [ExitWhenDone]
+	// Full and unreachable sessions must be dropped, the ranking must be ordered by score, and a fuller, closer
+	// session in the preferred region must rank first.
+	static void TestRanking(const TArray<FString>& Args)
+	{
+		const bool bExitWhenDone = Args.Contains(TEXT("ExitWhenDone"));
+
+		const UECRQuickPlayScorer* Scorer = GetDefault<UECRQuickPlayScorer>();
+
+		FECRQuickPlayPreferences Preferences;
+		Preferences.Region = TEXT("EU");
+
+		auto MakeCandidate = [](int32 PingInMs, int32 CurrentPlayerAmount, FName Region)
+		{
+			FECRQuickPlayCandidate Candidate;
+			Candidate.PingInMs = PingInMs;
+			Candidate.CurrentPlayerAmount = CurrentPlayerAmount;
+			Candidate.MaxPlayerAmount = 10;
+			Candidate.Region = Region;
+			return Candidate;
+		};
+
+		enum ECandidate { Best, Emptier, Full, Unreachable, OtherRegion, HigherPing };
+		const TArray<FECRQuickPlayCandidate> Candidates = {
+			MakeCandidate(50, 8, TEXT("EU")),
+			MakeCandidate(50, 1, TEXT("EU")),
+			MakeCandidate(50, 10, TEXT("EU")),
+			MakeCandidate(100000, 8, TEXT("EU")),
+			MakeCandidate(50, 8, TEXT("US")),
+			MakeCandidate(200, 8, TEXT("EU"))
+		};
+
+		TArray<TPair<int32, float>> Ranking;
+		Scorer->RankCandidates(Candidates, Preferences, Ranking);
+
+		bool bPassed = true;
+		auto Expect = [&bPassed](bool bCondition, const TCHAR* Description)
+		{
+			UE_LOG(LogECR, Log, TEXT("Quick play ranking test: %s%s"), Description, bCondition ? TEXT("") : TEXT(" FAILED"));
+			bPassed &= bCondition;
+		};
+
+		auto IsRanked = [&Ranking](int32 Index)
+		{
+			return Ranking.ContainsByPredicate([Index](const TPair<int32, float>& Entry) { return Entry.Key == Index; });
+		};
+
+		Expect(!IsRanked(Full) && !IsRanked(Unreachable), TEXT("full and unreachable sessions are dropped"));
+		Expect(IsRanked(Best) && IsRanked(Emptier) && IsRanked(OtherRegion) && IsRanked(HigherPing),
+		       TEXT("joinable sessions are ranked"));
+
+		bool bOrdered = true;
+		for (int32 Index = 1; Index < Ranking.Num(); ++Index)
+		{
+			bOrdered &= Ranking[Index - 1].Value >= Ranking[Index].Value;
+		}
+		Expect(bOrdered, TEXT("ranking is ordered by score"));
+		Expect(Ranking.Num() > 0 && Ranking[0].Key == Best, TEXT("fuller, closer session in the preferred region ranks first"));
+
+		for (const TPair<int32, float>& Entry : Ranking)
+		{
+			UE_LOG(LogECR, Log, TEXT("Quick play ranking test: candidate %d scored %.3f"), Entry.Key, Entry.Value);
+		}
+
+		UE_LOG(LogECR, Log, TEXT("Quick play ranking test %s"), bPassed ? TEXT("passed") : TEXT("failed"));
+
+		if (bExitWhenDone)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+		}
+	}
+
+	static FAutoConsoleCommand CmdTestRanking(
+		TEXT("ECR.QuickPlay.TestRanking"),
+		TEXT("Checks quick play candidate ranking on a synthetic session list. Usage: ECR.QuickPlay.TestRanking [ExitWhenDone]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(TestRanking));
+}
+
+
+float UECRQuickPlayScorer::ScoreCandidate(const FECRQuickPlayCandidate& Candidate,
+                                          const FECRQuickPlayPreferences& Preferences) const
+{
+	// Full or unreachable
+	if (Candidate.MaxPlayerAmount <= 0 || Candidate.CurrentPlayerAmount >= Candidate.MaxPlayerAmount
+		|| Candidate.PingInMs > MaxAcceptablePing)
+	{
+		return -1.f;
+	}
+
+	const float PingScore = 1.f - static_cast<float>(Candidate.PingInMs) / FMath::Max(MaxAcceptablePing, 1);
+
+	// Room for one more player is guaranteed above, so a session one short of full scores highest
+	const float FillScore = static_cast<float>(Candidate.CurrentPlayerAmount) / FMath::Max(Candidate.MaxPlayerAmount - 1, 1);
+
+	const float RegionScore = Preferences.Region.IsNone() || Preferences.Region == Candidate.Region ? 1.f : 0.f;
+
+	float FactionScore = 1.f;
+	if (Candidate.Alliances.Num() > 0)
+	{
+		int32 MinStrength = MAX_int32;
+		int32 MaxStrength = 0;
+		bool bHasPreferredFaction = Preferences.Faction.IsNone();
+		for (const FFactionAlliance& Alliance : Candidate.Alliances)
+		{
+			MinStrength = FMath::Min(MinStrength, Alliance.Strength);
+			MaxStrength = FMath::Max(MaxStrength, Alliance.Strength);
+			bHasPreferredFaction |= Alliance.FactionNames.Contains(Preferences.Faction);
+		}
+
+		const float BalanceScore = MaxStrength > 0 ? static_cast<float>(MinStrength) / MaxStrength : 1.f;
+		FactionScore = bHasPreferredFaction ? BalanceScore : 0.f;
+	}
+
+	const float TotalWeight = PingWeight + FillWeight + RegionWeight + FactionWeight;
+	if (TotalWeight <= 0.f)
+	{
+		return 0.f;
+	}
+
+	return (PingScore * PingWeight + FillScore * FillWeight + RegionScore * RegionWeight +
+		FactionScore * FactionWeight) / TotalWeight;
+}
+
+
+void UECRQuickPlayScorer::RankCandidates(const TArray<FECRQuickPlayCandidate>& Candidates,
+                                         const FECRQuickPlayPreferences& Preferences,
+                                         TArray<TPair<int32, float>>& OutRanking) const
+{
+	OutRanking.Reset(Candidates.Num());
+
+	for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+	{
+		const float Score = ScoreCandidate(Candidates[Index], Preferences);
+		if (Score >= 0.f)
+		{
+			OutRanking.Emplace(Index, Score);
+		}
+	}
+
+	OutRanking.StableSort([](const TPair<int32, float>& A, const TPair<int32, float>& B)
+	{
+		return A.Value > B.Value;
+	});
+}
@@ -0,0 +1,276 @@
+// Copyleft: All rights reversed
+
+
+#include "Online/ECRSessionBrowser.h"
+#include "System/ECRLogChannels.h"
+#include "System/MatchSettings.h"
+#include "OnlineSessionSettings.h"
+#include "HAL/IConsoleManager.h"
+
+
+namespace ECRSessionBrowser
+{
+	static int32 MaxSearchResults = 200;
+	static FAutoConsoleVariableRef CVarMaxSearchResults(
+		TEXT("ECR.SessionBrowser.MaxSearchResults"),
+		MaxSearchResults,
+		TEXT("Maximum amount of sessions requested by one session browser refresh"),
+		ECVF_Default);
+
+	static int32 MaxMissedRefreshes = 2;
+	static FAutoConsoleVariableRef CVarMaxMissedRefreshes(
+		TEXT("ECR.SessionBrowser.MaxMissedRefreshes"),
+		MaxMissedRefreshes,
+		TEXT("Consecutive refreshes a cached session can be missing from before it's removed from the server list"),
+		ECVF_Default);
+}
+
+
+bool FECRSessionBrowserFilter::operator==(const FECRSessionBrowserFilter& Other) const
+{
+	return GameVersion == Other.GameVersion
+		&& Mission == Other.Mission
+		&& Mode == Other.Mode
+		&& MapName == Other.MapName
+		&& Region == Other.Region
+		&& Factions == Other.Factions;
+}
+
+
+void FECRSessionBrowserFilter::ApplyTo(FOnlineSessionSearch& Search) const
+{
+	FECRMatchAdvertisement::AddSchemaQuery(Search);
+
+	if (!Mission.IsEmpty())
+	{
+		Search.QuerySettings.Set(SETTING_GAME_MISSION, Mission, EOnlineComparisonOp::Equals);
+	}
+	if (!Mode.IsEmpty())
+	{
+		Search.QuerySettings.Set(SETTING_GAMEMODE, Mode, EOnlineComparisonOp::Equals);
+	}
+	if (!MapName.IsEmpty())
+	{
+		Search.QuerySettings.Set(SETTING_MAPNAME, MapName, EOnlineComparisonOp::Equals);
+	}
+	if (!Region.IsEmpty())
+	{
+		Search.QuerySettings.Set(SETTING_REGION, Region, EOnlineComparisonOp::Equals);
+	}
+	if (!GameVersion.IsEmpty())
+	{
+		Search.QuerySettings.Set(SETTING_GAME_VERSION, GameVersion, EOnlineComparisonOp::Equals);
+	}
+
+	// Participating factions are advertised as separate boolean flags for filtering
+	for (const FName& FactionName : Factions)
+	{
+		Search.QuerySettings.Set(FName{SETTING_FACTION_PREFIX.ToString() + FactionName.ToString()}, true,
+		                         EOnlineComparisonOp::Equals);
+	}
+}
+
+
+FECRSessionBrowser::FECRSessionBrowser(const IOnlineSessionPtr& InSessionInterface, const bool bInIsLanQuery)
+	: SessionInterface(InSessionInterface),
+	  bIsLanQuery(bInIsLanQuery)
+{
+}
+
+
+FECRSessionBrowser::~FECRSessionBrowser()
+{
+	StopAutoRefresh();
+
+	if (const IOnlineSessionPtr SessionInterfacePtr = SessionInterface.Pin())
+	{
+		SessionInterfacePtr->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteHandle);
+	}
+}
+
+
+void FECRSessionBrowser::SetFilter(const FECRSessionBrowserFilter& InFilter)
+{
+	if (Filter != InFilter)
+	{
+		Filter = InFilter;
+		FilterSerial++;
+		ClearResults();
+	}
+}
+
+
+bool FECRSessionBrowser::Refresh()
+{
+	if (ActiveSearch.IsValid())
+	{
+		// Results of a search with an outdated filter will trigger a new refresh on completion
+		return true;
+	}
+
+	const IOnlineSessionPtr SessionInterfacePtr = SessionInterface.Pin();
+	if (!SessionInterfacePtr)
+	{
+		return false;
+	}
+
+	ActiveSearch = MakeShared<FOnlineSessionSearch>();
+	ActiveSearch->MaxSearchResults = ECRSessionBrowser::MaxSearchResults;
+	ActiveSearch->bIsLanQuery = bIsLanQuery;
+	Filter.ApplyTo(*ActiveSearch);
+	ActiveSearchFilterSerial = FilterSerial;
+
+	FindSessionsCompleteHandle = SessionInterfacePtr->AddOnFindSessionsCompleteDelegate_Handle(
+		FOnFindSessionsCompleteDelegate::CreateSP(this, &FECRSessionBrowser::HandleFindSessionsComplete));
+
+	if (!SessionInterfacePtr->FindSessions(0, ActiveSearch.ToSharedRef()))
+	{
+		// Completion delegate may have already fired synchronously with a failure
+		if (ActiveSearch.IsValid())
+		{
+			SessionInterfacePtr->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteHandle);
+			ActiveSearch.Reset();
+		}
+		return false;
+	}
+
+	return true;
+}
+
+
+void FECRSessionBrowser::StartAutoRefresh(const float Interval)
+{
+	StopAutoRefresh();
+	AutoRefreshHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &FECRSessionBrowser::HandleAutoRefresh), FMath::Max(Interval, 1.f));
+}
+
+
+void FECRSessionBrowser::StopAutoRefresh()
+{
+	if (AutoRefreshHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AutoRefreshHandle);
+		AutoRefreshHandle.Reset();
+	}
+}
+
+
+double FECRSessionBrowser::GetResultsAge() const
+{
+	return LastRefreshTime < 0.0 ? -1.0 : FPlatformTime::Seconds() - LastRefreshTime;
+}
+
+
+bool FECRSessionBrowser::HandleAutoRefresh(float DeltaTime)
+{
+	Refresh();
+	return true;
+}
+
+
+void FECRSessionBrowser::HandleFindSessionsComplete(const bool bWasSuccessful)
+{
+	// The delegate is shared by every search of the session interface, e.g. quick play, the search this browser
+	// started is marked done or failed before its completion is broadcast
+	if (ActiveSearch.IsValid() && ActiveSearch->SearchState == EOnlineAsyncTaskState::InProgress)
+	{
+		return;
+	}
+
+	if (const IOnlineSessionPtr SessionInterfacePtr = SessionInterface.Pin())
+	{
+		SessionInterfacePtr->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteHandle);
+	}
+
+	const TSharedPtr<FOnlineSessionSearch> CompletedSearch = MoveTemp(ActiveSearch);
+	if (!CompletedSearch.IsValid())
+	{
+		return;
+	}
+
+	// Filter changed while searching, these results don't belong to the current list
+	if (ActiveSearchFilterSerial != FilterSerial)
+	{
+		Refresh();
+		return;
+	}
+
+	if (bWasSuccessful)
+	{
+		MergeResults(CompletedSearch->SearchResults);
+		LastRefreshTime = FPlatformTime::Seconds();
+	}
+	else
+	{
+		UE_LOG(LogECR, Warning, TEXT("Session browser refresh failed, keeping %d cached sessions"), Results.Num());
+	}
+
+	OnResultsUpdated.Broadcast(bWasSuccessful);
+}
+
+
+void FECRSessionBrowser::ClearResults()
+{
+	Results.Reset();
+	MissedRefreshes.Reset();
+	ResultIndices.Reset();
+	LastRefreshTime = -1.0;
+}
+
+
+void FECRSessionBrowser::MergeResults(const TArray<FOnlineSessionSearchResult>& SearchResults)
+{
+	TBitArray<> SeenResults(false, Results.Num());
+
+	for (const FOnlineSessionSearchResult& SearchResult : SearchResults)
+	{
+		if (!SearchResult.IsValid())
+		{
+			continue;
+		}
+
+		if (const int32* ExistingIndex = ResultIndices.Find(SearchResult.GetSessionIdStr()))
+		{
+			if (Results[*ExistingIndex].UpdateDynamicSettings(SearchResult))
+			{
+				MissedRefreshes[*ExistingIndex] = 0;
+				SeenResults[*ExistingIndex] = true;
+			}
+		}
+		else
+		{
+			// Subsystems without server-side filtering (LAN) can still return sessions of other builds
+			FECRMatchResult NewResult{FBlueprintSessionResult{SearchResult}};
+			if (NewResult.bIsValid)
+			{
+				ResultIndices.Add(NewResult.SessionId, Results.Num());
+				Results.Add(MoveTemp(NewResult));
+				MissedRefreshes.Add(0);
+				// Keeps the bits in step with Results, the same session can come back twice in one search
+				SeenResults.Add(true);
+			}
+		}
+	}
+
+	// Age out cached sessions missing from this refresh, keeping the order of the rest
+	bool bRemovedAny = false;
+	for (int32 Index = SeenResults.Num() - 1; Index >= 0; --Index)
+	{
+		if (!SeenResults[Index] && ++MissedRefreshes[Index] > ECRSessionBrowser::MaxMissedRefreshes)
+		{
+			Results.RemoveAt(Index, 1, false);
+			MissedRefreshes.RemoveAt(Index, 1, false);
+			bRemovedAny = true;
+		}
+	}
+
+	if (bRemovedAny)
+	{
+		ResultIndices.Reset();
+		for (int32 Index = 0; Index < Results.Num(); ++Index)
+		{
+			ResultIndices.Add(Results[Index].SessionId, Index);
+		}
+	}
+}
@@ -0,0 +1,150 @@
+// Copyleft: All rights reversed
+
+
+#include "Online/ECRSessionSubsystem.h"
+#include "System/ECRLogChannels.h"
+#include "GameFramework/PlayerController.h"
+#if COMMONUSER_OSSV1
+#include "OnlineSessionSettings.h"
+#endif
+
+
+void UECRSessionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UClass* ScorerClass = QuickPlayScorerClass.IsNull()
+		                            ? UECRQuickPlayScorer::StaticClass()
+		                            : QuickPlayScorerClass.LoadSynchronous();
+	QuickPlayScorer = NewObject<UECRQuickPlayScorer>(this, ScorerClass ? ScorerClass : UECRQuickPlayScorer::StaticClass());
+}
+
+
+void UECRSessionSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(QuickPlayRetryHandle);
+
+	Super::Deinitialize();
+}
+
+
+void UECRSessionSubsystem::QuickPlaySession(APlayerController* JoiningOrHostingPlayer,
+                                            UCommonSession_HostSessionRequest* Request)
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(QuickPlayRetryHandle);
+	QuickPlayRetryHandle.Reset();
+
+	QuickPlaySearchCount = 0;
+	StartQuickPlaySearch(JoiningOrHostingPlayer, Request);
+}
+
+
+void UECRSessionSubsystem::StartQuickPlaySearch(APlayerController* JoiningOrHostingPlayer,
+                                                UCommonSession_HostSessionRequest* Request)
+{
+	QuickPlaySearchCount++;
+	Super::QuickPlaySession(JoiningOrHostingPlayer, Request);
+}
+
+
+TSharedRef<FCommonOnlineSearchSettings> UECRSessionSubsystem::CreateQuickPlaySearchSettings(
+	UCommonSession_HostSessionRequest* Request, UCommonSession_SearchSessionRequest* QuickPlayRequest)
+{
+	QuickPlaySearchRequest = QuickPlayRequest;
+	return Super::CreateQuickPlaySearchSettings(Request, QuickPlayRequest);
+}
+
+
+void UECRSessionSubsystem::HandleQuickPlaySearchFinished(const bool bSucceeded, const FText& ErrorMessage,
+                                                         const TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer,
+                                                         const TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
+{
+	UCommonSession_SearchSessionRequest* SearchRequest = QuickPlaySearchRequest;
+	QuickPlaySearchRequest = nullptr;
+
+	// Some OSS layers report a failure just because there are no sessions
+	if (SearchRequest && (bSucceeded || ErrorMessage.IsEmpty()))
+	{
+		TArray<FECRQuickPlayCandidate> Candidates;
+		TArray<UCommonSession_SearchResult*> CandidateResults;
+		GetQuickPlayCandidates(SearchRequest->Results, Candidates, CandidateResults);
+
+		TArray<TPair<int32, float>> Ranking;
+		QuickPlayScorer->RankCandidates(Candidates, QuickPlayPreferences, Ranking);
+
+		const float RequiredScore = MinQuickPlayScore - QuickPlayScoreRelaxPerSearch * (QuickPlaySearchCount - 1);
+		UE_LOG(LogECR, Log, TEXT("Quick play search %d: %d sessions, %d joinable, best score %.2f (required %.2f)"),
+		       QuickPlaySearchCount, SearchRequest->Results.Num(), Ranking.Num(),
+		       Ranking.Num() > 0 ? Ranking[0].Value : 0.f, RequiredScore);
+
+		if (Ranking.Num() > 0 && Ranking[0].Value >= RequiredScore)
+		{
+			JoinSession(JoiningOrHostingPlayer.Get(), CandidateResults[Ranking[0].Key]);
+			return;
+		}
+	}
+	else
+	{
+		UE_LOG(LogECR, Warning, TEXT("Quick play search %d failed: %s"), QuickPlaySearchCount, *ErrorMessage.ToString());
+	}
+
+	if (!JoiningOrHostingPlayer.IsValid())
+	{
+		return;
+	}
+
+	if (QuickPlaySearchCount < MaxQuickPlaySearches)
+	{
+		QuickPlayRetryHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(
+			this, [this, JoiningOrHostingPlayer, HostRequest](float)
+			{
+				QuickPlayRetryHandle.Reset();
+				if (JoiningOrHostingPlayer.IsValid())
+				{
+					StartQuickPlaySearch(JoiningOrHostingPlayer.Get(), HostRequest.Get());
+				}
+				return false;
+			}), QuickPlaySearchRetryDelay);
+		return;
+	}
+
+	HostSession(JoiningOrHostingPlayer.Get(), HostRequest.Get());
+}
+
+
+void UECRSessionSubsystem::GetQuickPlayCandidates(const TArray<UCommonSession_SearchResult*>& Results,
+                                                  TArray<FECRQuickPlayCandidate>& OutCandidates,
+                                                  TArray<UCommonSession_SearchResult*>& OutCandidateResults)
+{
+	OutCandidates.Reset(Results.Num());
+	OutCandidateResults.Reset(Results.Num());
+
+	for (UCommonSession_SearchResult* Result : Results)
+	{
+		if (!Result)
+		{
+			continue;
+		}
+
+		FECRQuickPlayCandidate Candidate;
+		Candidate.PingInMs = Result->GetPingInMs();
+		Candidate.MaxPlayerAmount = Result->GetMaxPublicConnections();
+
+#if COMMONUSER_OSSV1
+		FECRMatchAdvertisement Advertisement;
+		if (!Advertisement.Read(Result->Result.Session.SessionSettings))
+		{
+			continue;
+		}
+		// Open connections aren't updated as players join, the advertised amount is kept up to date by the game mode
+		Candidate.CurrentPlayerAmount = Advertisement.CurrentPlayerAmount;
+		Candidate.Region = Advertisement.Region;
+		Candidate.Alliances = MoveTemp(Advertisement.Alliances);
+#else
+		Candidate.CurrentPlayerAmount = Candidate.MaxPlayerAmount - Result->GetNumOpenPublicConnections();
+#endif
+
+		OutCandidates.Add(MoveTemp(Candidate));
+		OutCandidateResults.Add(Result);
+	}
+}
@@ -0,0 +1,725 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NativeGameplayTags.h"
+#include "GameplayEffect.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Net/RepLayout.h"
+#include "UObject/CoreNet.h"
+#include "Customization/CustomizationLoaderAsset.h"
+#include "Customization/CustomizationLoaderComponent.h"
+#include "Gameplay/ECRGameplayTags.h"
+#include "Gameplay/GAS/ECRAbilitySystemComponent.h"
+#include "Gameplay/GAS/Attributes/ECRCharacterHealthSet.h"
+#include "Gameplay/GAS/Attributes/ECRCombatSet.h"
+#include "Gameplay/GAS/Executions/ECRDamageExecution.h"
+#include "Gameplay/Inventory/ECRInventoryItemDefinition.h"
+#include "Gameplay/Inventory/ECRInventoryManagerComponent.h"
+#include "Gameplay/Weapons/ECRGameplayAbility_RangedWeapon.h"
+#include "System/GameplayTagStack.h"
+#include "System/ECRLogChannels.h"
+#include "System/Messages/ECRVerbMessage.h"
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_ECR_Benchmark_Message, "ECR.Benchmark.Message");
+
+// Headless micro benchmarks for ECR hot paths. Run with
+//   ECR.Benchmark.Run [Filter=<substring>] [Iterations=N] [Baseline=<csv>] [Threshold=<percent>] [ExitWhenDone]
+// Results are written as CSV to Saved/Profiling/Benchmarks. When a baseline is given, a benchmark whose median
+// per-iteration time exceeds the baseline by more than the threshold is reported as a regression, and
+// ExitWhenDone makes the process exit with a non-zero code so release pipelines can fail on it.
+namespace ECRBenchmarks
+{
+	static constexpr int32 NumSamples = 7;
+	static constexpr int32 RandomSeed = 1337;
+
+	static FString CustomizationAssetPath;
+	static FAutoConsoleVariableRef CVarCustomizationAsset(
+		TEXT("ECR.Benchmark.CustomizationAsset"),
+		CustomizationAssetPath,
+		TEXT("Customization loader asset used by the Customization.Load benchmark"),
+		ECVF_Default);
+
+	class FBenchmark
+	{
+	public:
+		virtual ~FBenchmark() {}
+
+		virtual const TCHAR* GetName() const = 0;
+
+		// Returns false if the benchmark can't run in this world, it is then skipped
+		virtual bool Setup(UWorld* World) { return true; }
+
+		virtual void Run(int32 Iterations) = 0;
+
+		virtual void Teardown() {}
+	};
+
+	struct FResult
+	{
+		FString Name;
+		int32 Iterations = 0;
+		double MinNs = 0.0;
+		double MedianNs = 0.0;
+		double MaxNs = 0.0;
+	};
+
+	static AActor* SpawnBenchmarkActor(UWorld* World)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.ObjectFlags |= RF_Transient;
+		SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnInfo);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+
+	class FMessageBroadcastBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("Messages.Broadcast"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			MessageSubsystem = &UGameplayMessageSubsystem::Get(World);
+
+			// Roughly what a HUD, killfeed and a few gameplay listeners add up to
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				Listeners.Add(MessageSubsystem->RegisterListener<FECRVerbMessage>(
+					TAG_ECR_Benchmark_Message,
+					[this](FGameplayTag, const FECRVerbMessage& Message) { Sink += Message.Magnitude; }));
+			}
+
+			Message.Verb = TAG_ECR_Benchmark_Message;
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				MessageSubsystem->BroadcastMessage(TAG_ECR_Benchmark_Message, Message);
+			}
+		}
+
+		virtual void Teardown() override
+		{
+			for (FGameplayMessageListenerHandle& Handle : Listeners)
+			{
+				Handle.Unregister();
+			}
+			Listeners.Reset();
+		}
+
+	private:
+		UGameplayMessageSubsystem* MessageSubsystem = nullptr;
+		TArray<FGameplayMessageListenerHandle> Listeners;
+		FECRVerbMessage Message;
+		double Sink = 0.0;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	// Runs UECRGameplayAbility_RangedWeapon::DoSingleBulletTrace on a granted ability instance: a complex line
+	// trace on the weapon channel, followed by a sweep when the line didn't hit a pawn
+	class FWeaponTraceBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("Weapon.Trace"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			Actor = SpawnBenchmarkActor(World);
+			if (Actor == nullptr)
+			{
+				return false;
+			}
+
+			UECRAbilitySystemComponent* AbilitySystem = NewObject<UECRAbilitySystemComponent>(Actor);
+			AbilitySystem->RegisterComponent();
+			AbilitySystem->InitAbilityActorInfo(Actor, Actor);
+
+			const FGameplayAbilitySpecHandle Handle = AbilitySystem->GiveAbility(
+				FGameplayAbilitySpec(UECRGameplayAbility_RangedWeapon::StaticClass(), 1));
+			const FGameplayAbilitySpec* Spec = AbilitySystem->FindAbilitySpecFromHandle(Handle);
+			Ability = Spec ? Cast<UECRGameplayAbility_RangedWeapon>(Spec->GetPrimaryInstance()) : nullptr;
+			if (Ability == nullptr)
+			{
+				UE_LOG(LogECR, Warning, TEXT("Skipping %s, failed to instance the ranged weapon ability"), GetName());
+				return false;
+			}
+
+			TArray<FVector> Origins;
+			for (TActorIterator<APlayerStart> It(World); It; ++It)
+			{
+				Origins.Add(It->GetActorLocation() + FVector(0.f, 0.f, 60.f));
+			}
+			if (Origins.Num() == 0)
+			{
+				Origins.Add(FVector(0.f, 0.f, 200.f));
+			}
+
+			FRandomStream RandomStream(RandomSeed);
+			for (int32 Index = 0; Index < 64; ++Index)
+			{
+				const FVector Start = Origins[Index % Origins.Num()];
+				Traces.Emplace(Start, Start + RandomStream.VRand() * 10000.f);
+			}
+
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			TArray<FHitResult> HitResults;
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				const TPair<FVector, FVector>& Trace = Traces[Index % Traces.Num()];
+
+				HitResults.Reset();
+				Ability->DoSingleBulletTrace(Trace.Key, Trace.Value, /*SweepRadius=*/ 5.f, /*bIsSimulated=*/ false,
+				                             /*out*/ HitResults, /*bSuppressDebugDraw=*/ true);
+			}
+		}
+
+		virtual void Teardown() override
+		{
+			Ability = nullptr;
+			if (Actor)
+			{
+				Actor->Destroy();
+				Actor = nullptr;
+			}
+		}
+
+	private:
+		AActor* Actor = nullptr;
+		UECRGameplayAbility_RangedWeapon* Ability = nullptr;
+		TArray<TPair<FVector, FVector>> Traces;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	class FDamageExecutionBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("GAS.DamageExecution"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			Actor = SpawnBenchmarkActor(World);
+			if (Actor == nullptr)
+			{
+				return false;
+			}
+
+			AbilitySystem = NewObject<UECRAbilitySystemComponent>(Actor);
+			AbilitySystem->RegisterComponent();
+			AbilitySystem->AddSpawnedAttribute(NewObject<UECRCharacterHealthSet>(Actor));
+			AbilitySystem->AddSpawnedAttribute(NewObject<UECRCombatSet>(Actor));
+			AbilitySystem->InitAbilityActorInfo(Actor, Actor);
+			AbilitySystem->SetNumericAttributeBase(UECRCombatSet::GetBaseDamageAttribute(), 1.f);
+
+			DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), NAME_None, RF_Transient);
+			DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+			FGameplayEffectExecutionDefinition& Execution = DamageEffect->Executions.AddDefaulted_GetRef();
+			Execution.CalculationClass = UECRDamageExecution::StaticClass();
+			DamageEffect->AddToRoot();
+
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			const FGameplayEffectContextHandle Context = AbilitySystem->MakeEffectContext();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				// Keep the target alive so every iteration takes the same path through the health set
+				AbilitySystem->SetNumericAttributeBase(UECRHealthSet::GetHealthAttribute(), 100000.f);
+				AbilitySystem->ApplyGameplayEffectToSelf(DamageEffect, 1.f, Context);
+			}
+		}
+
+		virtual void Teardown() override
+		{
+			if (DamageEffect)
+			{
+				DamageEffect->RemoveFromRoot();
+				DamageEffect = nullptr;
+			}
+			if (Actor)
+			{
+				Actor->Destroy();
+				Actor = nullptr;
+			}
+		}
+
+	private:
+		AActor* Actor = nullptr;
+		UECRAbilitySystemComponent* AbilitySystem = nullptr;
+		UGameplayEffect* DamageEffect = nullptr;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	class FTagStackBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("Tags.StackMutation"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			const FECRGameplayTags& GameplayTags = FECRGameplayTags::Get();
+			Tags = {
+				GameplayTags.Status_Crouching, GameplayTags.Status_ADS, GameplayTags.Status_AutoRunning,
+				GameplayTags.Status_Bracing, GameplayTags.Status_Death, GameplayTags.Status_JumpFlying,
+				GameplayTags.Status_Wounded, GameplayTags.Cheat_GodMode
+			};
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				const FGameplayTag& Tag = Tags[Index % Tags.Num()];
+				Container.AddStack(Tag, 2);
+				Sink += Container.GetStackCount(Tag);
+				Container.RemoveStack(Tag, 1);
+			}
+
+			// Leave the container as we found it so every sample starts from the same state
+			for (const FGameplayTag& Tag : Tags)
+			{
+				Container.RemoveStack(Tag, Container.GetStackCount(Tag));
+			}
+		}
+
+	private:
+		TArray<FGameplayTag> Tags;
+		FGameplayTagStackContainer Container;
+		int32 Sink = 0;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	// Server side of inventory replication: creating instances, marking fast array items dirty and the
+	// definition index upkeep that runs for every replicated add and remove
+	class FInventoryFastArrayBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("Inventory.FastArray"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			Actor = SpawnBenchmarkActor(World);
+			if (Actor == nullptr)
+			{
+				return false;
+			}
+
+			Inventory = NewObject<UECRInventoryManagerComponent>(Actor);
+			Inventory->RegisterComponent();
+
+			// A realistic loadout to search through
+			for (int32 Index = 0; Index < 16; ++Index)
+			{
+				Inventory->AddItemDefinition(UECRInventoryItemDefinition::StaticClass(), 1);
+			}
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				UECRInventoryItemInstance* Instance = Inventory->AddItemDefinition(UECRInventoryItemDefinition::StaticClass(), 1);
+				Sink += Inventory->GetTotalItemCountByDefinition(UECRInventoryItemDefinition::StaticClass());
+				Inventory->RemoveItemInstance(Instance);
+			}
+		}
+
+		virtual void Teardown() override
+		{
+			if (Actor)
+			{
+				Actor->Destroy();
+				Actor = nullptr;
+			}
+		}
+
+	private:
+		AActor* Actor = nullptr;
+		UECRInventoryManagerComponent* Inventory = nullptr;
+		int32 Sink = 0;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	// Both ends of inventory replication: NetDeltaSerialize of a changed list through a live connection's package
+	// map, and reading it into a second list, which runs the PostReplicatedAdd/PreReplicatedRemove callbacks.
+	// Needs a net driver with a connection, so run it on a server with a connected client.
+	class FInventoryReplicationBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("Inventory.NetDeltaSerialize"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			UNetDriver* NetDriver = World->GetNetDriver();
+			if (NetDriver != nullptr)
+			{
+				Connection = NetDriver->ServerConnection ? NetDriver->ServerConnection.Get()
+				           : (NetDriver->ClientConnections.Num() > 0 ? NetDriver->ClientConnections[0].Get() : nullptr);
+			}
+			if (Connection == nullptr || Connection->PackageMap == nullptr)
+			{
+				UE_LOG(LogECR, Log, TEXT("Skipping %s, it needs a net connection to serialize through"), GetName());
+				return false;
+			}
+
+			SerializeCB = MakeUnique<FNetSerializeCB>(NetDriver);
+
+			ServerActor = SpawnBenchmarkActor(World);
+			ClientActor = SpawnBenchmarkActor(World);
+			if (ServerActor == nullptr || ClientActor == nullptr)
+			{
+				return false;
+			}
+
+			UECRInventoryManagerComponent* ServerInventory = NewObject<UECRInventoryManagerComponent>(ServerActor);
+			ServerInventory->RegisterComponent();
+			UECRInventoryManagerComponent* ClientInventory = NewObject<UECRInventoryManagerComponent>(ClientActor);
+			ClientInventory->RegisterComponent();
+
+			ServerList = MakeUnique<FECRInventoryList>(ServerInventory);
+			ClientList = MakeUnique<FECRInventoryList>(ClientInventory);
+
+			// Same loadout as Inventory.FastArray, replicated once so iterations only send the delta
+			for (int32 Index = 0; Index < 16; ++Index)
+			{
+				ServerList->AddEntry(UECRInventoryItemDefinition::StaticClass(), 1);
+			}
+			Replicate();
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				UECRInventoryItemInstance* Instance = ServerList->AddEntry(UECRInventoryItemDefinition::StaticClass(), 1);
+				Replicate();
+				ServerList->RemoveEntry(Instance);
+				Replicate();
+			}
+		}
+
+		virtual void Teardown() override
+		{
+			ServerList.Reset();
+			ClientList.Reset();
+			BaseState.Reset();
+			GuidReferencesMap.Reset();
+			SerializeCB.Reset();
+			Connection = nullptr;
+
+			for (AActor* Actor : { ServerActor, ClientActor })
+			{
+				if (Actor)
+				{
+					Actor->Destroy();
+				}
+			}
+			ServerActor = nullptr;
+			ClientActor = nullptr;
+		}
+
+	private:
+		void Replicate()
+		{
+			FNetBitWriter Writer(Connection->PackageMap, 0);
+
+			TSharedPtr<INetDeltaBaseState> NewState;
+			FNetDeltaSerializeInfo WriteParms;
+			WriteParms.Writer = &Writer;
+			WriteParms.Map = Connection->PackageMap;
+			WriteParms.NetSerializeCB = SerializeCB.Get();
+			WriteParms.Struct = FECRInventoryList::StaticStruct();
+			WriteParms.OldState = BaseState.Get();
+			WriteParms.NewState = &NewState;
+			if (!ServerList->NetDeltaSerialize(WriteParms))
+			{
+				return;
+			}
+			BaseState = NewState;
+
+			FNetBitReader Reader(Connection->PackageMap, Writer.GetData(), Writer.GetNumBits());
+			FNetDeltaSerializeInfo ReadParms;
+			ReadParms.Reader = &Reader;
+			ReadParms.Map = Connection->PackageMap;
+			ReadParms.NetSerializeCB = SerializeCB.Get();
+			ReadParms.Struct = FECRInventoryList::StaticStruct();
+			ReadParms.Object = ClientActor;
+			ReadParms.GuidReferencesMap = &GuidReferencesMap;
+			ClientList->NetDeltaSerialize(ReadParms);
+		}
+
+		UNetConnection* Connection = nullptr;
+		TUniquePtr<FNetSerializeCB> SerializeCB;
+		AActor* ServerActor = nullptr;
+		AActor* ClientActor = nullptr;
+		TUniquePtr<FECRInventoryList> ServerList;
+		TUniquePtr<FECRInventoryList> ClientList;
+		TSharedPtr<INetDeltaBaseState> BaseState;
+		FGuidReferencesMap GuidReferencesMap;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	class FCustomizationLoadBenchmark : public FBenchmark
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("Customization.Load"); }
+
+		virtual bool Setup(UWorld* World) override
+		{
+			if (CustomizationAssetPath.IsEmpty())
+			{
+				UE_LOG(LogECR, Log, TEXT("Skipping %s, set ECR.Benchmark.CustomizationAsset to run it"), GetName());
+				return false;
+			}
+
+			LoaderAsset = LoadObject<UCustomizationLoaderAsset>(nullptr, *CustomizationAssetPath);
+			if (LoaderAsset == nullptr)
+			{
+				UE_LOG(LogECR, Warning, TEXT("Skipping %s, failed to load %s"), GetName(), *CustomizationAssetPath);
+				return false;
+			}
+			LoaderAsset->AddToRoot();
+
+			Actor = SpawnBenchmarkActor(World);
+			if (Actor == nullptr)
+			{
+				return false;
+			}
+
+			USkeletalMeshComponent* Mesh = NewObject<USkeletalMeshComponent>(Actor);
+			Actor->SetRootComponent(Mesh);
+			Mesh->RegisterComponent();
+
+			Loader = NewObject<UCustomizationLoaderComponent>(Actor);
+			Loader->SetupAttachment(Mesh);
+			Loader->RegisterComponent();
+
+			// Dedicated servers skip cosmetic-only loads, measure the full load clients do
+			StripCosmeticsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ECR.ServerCosmetics.Strip"));
+			if (StripCosmeticsCVar)
+			{
+				bPreviousStripCosmetics = StripCosmeticsCVar->GetBool();
+				StripCosmeticsCVar->Set(false, ECVF_SetByCode);
+			}
+			return true;
+		}
+
+		virtual void Run(int32 Iterations) override
+		{
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				Loader->LoadFromAsset(LoaderAsset->ElementaryAssets, {});
+				Loader->UnloadPreviousCustomization();
+			}
+		}
+
+		virtual void Teardown() override
+		{
+			if (StripCosmeticsCVar)
+			{
+				StripCosmeticsCVar->Set(bPreviousStripCosmetics, ECVF_SetByCode);
+				StripCosmeticsCVar = nullptr;
+			}
+			if (LoaderAsset)
+			{
+				LoaderAsset->RemoveFromRoot();
+				LoaderAsset = nullptr;
+			}
+			if (Actor)
+			{
+				Actor->Destroy();
+				Actor = nullptr;
+			}
+		}
+
+	private:
+		UCustomizationLoaderAsset* LoaderAsset = nullptr;
+		AActor* Actor = nullptr;
+		UCustomizationLoaderComponent* Loader = nullptr;
+		IConsoleVariable* StripCosmeticsCVar = nullptr;
+		bool bPreviousStripCosmetics = false;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+
+	static FResult RunBenchmark(FBenchmark& Benchmark, int32 Iterations)
+	{
+		FResult Result;
+		Result.Name = Benchmark.GetName();
+		Result.Iterations = Iterations;
+
+		// Warm caches and lazily created state so the first sample isn't an outlier
+		Benchmark.Run(FMath::Max(Iterations / 10, 1));
+
+		TArray<double> SampleNs;
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Benchmark.Run(Iterations);
+			SampleNs.Add((FPlatformTime::Seconds() - StartTime) * 1e9 / Iterations);
+		}
+
+		SampleNs.Sort();
+		Result.MinNs = SampleNs[0];
+		Result.MedianNs = SampleNs[NumSamples / 2];
+		Result.MaxNs = SampleNs.Last();
+		return Result;
+	}
+
+	static TMap<FString, double> LoadBaseline(const FString& FilePath)
+	{
+		TMap<FString, double> Baseline;
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+		{
+			UE_LOG(LogECR, Error, TEXT("Failed to read benchmark baseline %s"), *FilePath);
+			return Baseline;
+		}
+
+		// Skip the header, columns match WriteResults
+		for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+		{
+			TArray<FString> Columns;
+			Lines[LineIndex].ParseIntoArray(Columns, TEXT(","));
+			if (Columns.Num() >= 4)
+			{
+				Baseline.Add(Columns[0], FCString::Atod(*Columns[3]));
+			}
+		}
+
+		return Baseline;
+	}
+
+	static void WriteResults(const TArray<FResult>& Results)
+	{
+		FString Csv = TEXT("Name,Iterations,MinNs,MedianNs,MaxNs\n");
+		for (const FResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%.1f,%.1f,%.1f\n"),
+			                       *Result.Name, Result.Iterations, Result.MinNs, Result.MedianNs, Result.MaxNs);
+		}
+
+		const FString FilePath = FPaths::ProfilingDir() / TEXT("Benchmarks") /
+			FString::Printf(TEXT("ECRBenchmarks-%s.csv"), *FDateTime::Now().ToString());
+
+		if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+		{
+			UE_LOG(LogECR, Log, TEXT("Benchmark results written to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogECR, Error, TEXT("Failed to write benchmark results to %s"), *FilePath);
+		}
+	}
+
+	static void RunBenchmarks(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || !World->IsGameWorld())
+		{
+			UE_LOG(LogECR, Warning, TEXT("ECR.Benchmark.Run needs a game world"));
+			return;
+		}
+
+		const FString CommandLine = FString::Join(Args, TEXT(" "));
+
+		FString Filter;
+		FParse::Value(*CommandLine, TEXT("Filter="), Filter);
+
+		int32 Iterations = 1000;
+		FParse::Value(*CommandLine, TEXT("Iterations="), Iterations);
+		Iterations = FMath::Max(Iterations, 1);
+
+		FString BaselinePath;
+		FParse::Value(*CommandLine, TEXT("Baseline="), BaselinePath);
+
+		float ThresholdPercent = 10.f;
+		FParse::Value(*CommandLine, TEXT("Threshold="), ThresholdPercent);
+
+		const bool bExitWhenDone = FParse::Param(*CommandLine, TEXT("ExitWhenDone")) || Args.Contains(TEXT("ExitWhenDone"));
+
+		TArray<TUniquePtr<FBenchmark>> Benchmarks;
+		Benchmarks.Add(MakeUnique<FMessageBroadcastBenchmark>());
+		Benchmarks.Add(MakeUnique<FWeaponTraceBenchmark>());
+		Benchmarks.Add(MakeUnique<FDamageExecutionBenchmark>());
+		Benchmarks.Add(MakeUnique<FTagStackBenchmark>());
+		Benchmarks.Add(MakeUnique<FInventoryFastArrayBenchmark>());
+		Benchmarks.Add(MakeUnique<FInventoryReplicationBenchmark>());
+		Benchmarks.Add(MakeUnique<FCustomizationLoadBenchmark>());
+
+		TArray<FResult> Results;
+		for (const TUniquePtr<FBenchmark>& Benchmark : Benchmarks)
+		{
+			if (!Filter.IsEmpty() && !FCString::Stristr(Benchmark->GetName(), *Filter))
+			{
+				continue;
+			}
+
+			// Don't let garbage from a previous benchmark get collected in the middle of this one
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+			if (Benchmark->Setup(World))
+			{
+				const FResult& Result = Results.Add_GetRef(RunBenchmark(*Benchmark, Iterations));
+				UE_LOG(LogECR, Log, TEXT("Benchmark %s: %.1fns median, %.1fns min, %.1fns max per iteration"),
+				       *Result.Name, Result.MedianNs, Result.MinNs, Result.MaxNs);
+			}
+			Benchmark->Teardown();
+		}
+
+		WriteResults(Results);
+
+		bool bRegressed = false;
+		if (!BaselinePath.IsEmpty())
+		{
+			const TMap<FString, double> Baseline = LoadBaseline(BaselinePath);
+			for (const FResult& Result : Results)
+			{
+				const double* BaselineNs = Baseline.Find(Result.Name);
+				if (BaselineNs && *BaselineNs > 0.0 && Result.MedianNs > *BaselineNs * (1.0 + ThresholdPercent / 100.0))
+				{
+					UE_LOG(LogECR, Error, TEXT("Benchmark %s regressed: %.1fns against a baseline of %.1fns (threshold %.0f%%)"),
+					       *Result.Name, Result.MedianNs, *BaselineNs, ThresholdPercent);
+					bRegressed = true;
+				}
+			}
+		}
+
+		if (bExitWhenDone)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, bRegressed ? 1 : 0);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdRunBenchmarks(
+		TEXT("ECR.Benchmark.Run"),
+		TEXT("Runs ECR gameplay benchmarks. Usage: ECR.Benchmark.Run [Filter=<name>] [Iterations=1000] [Baseline=<csv>] [Threshold=10] [ExitWhenDone]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(RunBenchmarks));
+}
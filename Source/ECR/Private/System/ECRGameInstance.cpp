@@ -8,7 +8,34 @@
 #include "ECRUtilsLibrary.h"
 #include "OnlineSubsystem.h"
 #include "Algo/Accumulate.h"
+#include "HAL/IConsoleManager.h"
 #include "Interfaces/OnlineIdentityInterface.h"
+#include "Online/ECRSessionBrowser.h"
+
+
+namespace ECRGameInstance
+{
+	static float MatchListCacheLifetime = 5.f;
+	static FAutoConsoleVariableRef CVarMatchListCacheLifetime(
+		TEXT("ECR.SessionBrowser.CacheLifetime"),
+		MatchListCacheLifetime,
+		TEXT("Seconds the cached server list is shown without refreshing when searching with the same filter"),
+		ECVF_Default);
+
+	static FString SessionBrowserSubsystem;
+	static FAutoConsoleVariableRef CVarSessionBrowserSubsystem(
+		TEXT("ECR.SessionBrowser.OnlineSubsystem"),
+		SessionBrowserSubsystem,
+		TEXT("Online subsystem used for the server list instead of the default one (e.g. NULL for local LAN sessions). Read on first search."),
+		ECVF_Default);
+
+	static float MinSessionUpdateInterval = 10.f;
+	static FAutoConsoleVariableRef CVarMinSessionUpdateInterval(
+		TEXT("ECR.SessionAdvertisement.MinUpdateInterval"),
+		MinSessionUpdateInterval,
+		TEXT("Minimum seconds between pushes of changed session settings (player amount, match state) to the online service"),
+		ECVF_Default);
+}
 
 
 UECRGameInstance::UECRGameInstance()
@@ -123,24 +150,6 @@ void UECRGameInstance::OnLogoutComplete(int32 LocalUserNum, bool bWasSuccessful)
 }
 
 
-FString UECRGameInstance::GetMatchFactionString(
-	const TArray<FFactionAlliance>& FactionAlliances, const TMap<FName, FText>& FactionNamesToShortTexts)
-{
-	TArray<FString> Sides;
-	for (FFactionAlliance Alliance : FactionAlliances)
-	{
-		TArray<FString> SideFactions;
-		for (FName FactionName : Alliance.FactionNames)
-		{
-			const FText* FactionShortNameText = FactionNamesToShortTexts.Find(FactionName);
-			SideFactions.Add(FactionShortNameText->ToString());
-		}
-		Sides.Add(FString::Join(SideFactions, TEXT(", ")));
-	}
-	return FString::Join(Sides, TEXT(" vs "));
-}
-
-
 void UECRGameInstance::CreateMatch(const FString GameVersion, const FName ModeName, const FName MapName,
                                    const FString MapPath, const FName MissionName,
                                    const FName RegionName, const double TimeDelta,
@@ -181,42 +190,84 @@ void UECRGameInstance::CreateMatch(const FString GameVersion, const FName ModeNa
 }
 
 
-void UECRGameInstance::FindMatches(const FString GameVersion, const FString MatchType, const FString MatchMode,
-                                   const FString MapName, const FString
-                                   RegionName)
+void UECRGameInstance::FindMatches(const TArray<FName>& Factions, const FString GameVersion, const FString MatchType,
+                                   const FString MatchMode, const FString MapName, const FString RegionName)
 {
-	if (OnlineSubsystem)
+	FECRSessionBrowser* Browser = GetSessionBrowser();
+	if (!Browser)
 	{
-		if (const IOnlineSessionPtr OnlineSessionPtr = OnlineSubsystem->GetSessionInterface())
+		return;
+	}
+
+	FECRSessionBrowserFilter Filter;
+	Filter.GameVersion = GameVersion;
+	Filter.Mission = MatchType;
+	Filter.Mode = MatchMode;
+	Filter.MapName = MapName;
+	Filter.Region = RegionName;
+	Filter.Factions = Factions;
+	Browser->SetFilter(Filter);
+
+	// Show what is already known for this filter while refreshing
+	if (Browser->GetResultsAge() >= 0.0)
+	{
+		if (AECRGUIPlayerController* GUISupervisor = UECRUtilsLibrary::GetGUISupervisor(GetWorld()))
 		{
-			SessionSearchSettings = MakeShareable(new FOnlineSessionSearch{});
-			SessionSearchSettings->MaxSearchResults = 10;
-
-			// If specified parameters, do filter
-			if (MatchType != "")
-				SessionSearchSettings->QuerySettings.Set(
-					SETTING_GAME_MISSION, MatchType, EOnlineComparisonOp::Equals);
-			if (MatchMode != "")
-				SessionSearchSettings->QuerySettings.Set(
-					SETTING_GAMEMODE, MatchMode, EOnlineComparisonOp::Equals);
-			if (MapName != "")
-				SessionSearchSettings->QuerySettings.Set(
-					SETTING_MAPNAME, MapName, EOnlineComparisonOp::Equals);
-			if (RegionName != "")
-				SessionSearchSettings->QuerySettings.Set(
-					SETTING_REGION, RegionName, EOnlineComparisonOp::Equals);
-			if (GameVersion != "")
-				SessionSearchSettings->QuerySettings.Set(
-					SETTING_GAME_VERSION, GameVersion, EOnlineComparisonOp::Equals);
-
-			OnlineSessionPtr->OnFindSessionsCompleteDelegates.AddUObject(
-				this, &UECRGameInstance::OnFindMatchesComplete);
-			OnlineSessionPtr->FindSessions(0, SessionSearchSettings.ToSharedRef());
+			GUISupervisor->HandleFindMatchesSuccess(Browser->GetResults());
 		}
+
+		if (Browser->GetResultsAge() < ECRGameInstance::MatchListCacheLifetime)
+		{
+			return;
+		}
+	}
+
+	if (!Browser->Refresh())
+	{
+		OnFindMatchesComplete(false);
 	}
 }
 
 
+void UECRGameInstance::StartMatchListAutoRefresh(const float Interval)
+{
+	if (FECRSessionBrowser* Browser = GetSessionBrowser())
+	{
+		Browser->StartAutoRefresh(Interval);
+	}
+}
+
+
+void UECRGameInstance::StopMatchListAutoRefresh()
+{
+	if (SessionBrowser.IsValid())
+	{
+		SessionBrowser->StopAutoRefresh();
+	}
+}
+
+
+FECRSessionBrowser* UECRGameInstance::GetSessionBrowser()
+{
+	if (!SessionBrowser.IsValid())
+	{
+		// Allows running the server list against a local subsystem, e.g. NULL with LAN sessions
+		IOnlineSubsystem* BrowserSubsystem = ECRGameInstance::SessionBrowserSubsystem.IsEmpty()
+			                                     ? OnlineSubsystem
+			                                     : IOnlineSubsystem::Get(FName{*ECRGameInstance::SessionBrowserSubsystem});
+		if (!BrowserSubsystem || !BrowserSubsystem->GetSessionInterface())
+		{
+			return nullptr;
+		}
+
+		const bool bIsLanQuery = BrowserSubsystem->GetSubsystemName() == NULL_SUBSYSTEM;
+		SessionBrowser = MakeShared<FECRSessionBrowser>(BrowserSubsystem->GetSessionInterface(), bIsLanQuery);
+		SessionBrowser->OnResultsUpdated.AddUObject(this, &UECRGameInstance::OnFindMatchesComplete);
+	}
+	return SessionBrowser.Get();
+}
+
+
 void UECRGameInstance::JoinMatch(const FBlueprintSessionResult Session)
 {
 	if (OnlineSubsystem)
@@ -236,33 +287,111 @@ void UECRGameInstance::JoinMatch(const FBlueprintSessionResult Session)
 
 
 void UECRGameInstance::UpdateSessionSettings()
+{
+	bSessionAdvertisementDirty = true;
+
+	// Coalesce changes while an update is pending or running, the latest values are pushed once it finishes
+	if (bSessionAdvertisementUpdateInFlight || SessionAdvertisementTickerHandle.IsValid())
+	{
+		return;
+	}
+
+	const double Delay = LastSessionAdvertisementUpdateTime + ECRGameInstance::MinSessionUpdateInterval -
+		FPlatformTime::Seconds();
+	if (Delay <= 0.0)
+	{
+		FlushSessionSettings(0.f);
+	}
+	else
+	{
+		SessionAdvertisementTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UECRGameInstance::FlushSessionSettings), Delay);
+	}
+}
+
+bool UECRGameInstance::FlushSessionSettings(float DeltaTime)
+{
+	SessionAdvertisementTickerHandle.Reset();
+
+	if (!bSessionAdvertisementDirty || !OnlineSubsystem)
+	{
+		return false;
+	}
+
+	const IOnlineSessionPtr OnlineSessionPtr = OnlineSubsystem->GetSessionInterface();
+	if (!OnlineSessionPtr || !OnlineSessionPtr->GetNamedSession(DEFAULT_SESSION_NAME))
+	{
+		return false;
+	}
+
+	bSessionAdvertisementDirty = false;
+	bSessionAdvertisementUpdateInFlight = true;
+	LastSessionAdvertisementUpdateTime = FPlatformTime::Seconds();
+
+	UpdateSessionCompleteHandle = OnlineSessionPtr->AddOnUpdateSessionCompleteDelegate_Handle(
+		FOnUpdateSessionCompleteDelegate::CreateUObject(this, &UECRGameInstance::OnUpdateSessionComplete));
+
+	FOnlineSessionSettings SessionSettings = GetSessionSettings();
+	if (!OnlineSessionPtr->UpdateSession(DEFAULT_SESSION_NAME, SessionSettings, true) &&
+		bSessionAdvertisementUpdateInFlight)
+	{
+		OnlineSessionPtr->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteHandle);
+		bSessionAdvertisementUpdateInFlight = false;
+	}
+
+	// One shot
+	return false;
+}
+
+void UECRGameInstance::OnUpdateSessionComplete(FName SessionName, const bool bWasSuccessful)
 {
 	if (OnlineSubsystem)
 	{
 		if (const IOnlineSessionPtr OnlineSessionPtr = OnlineSubsystem->GetSessionInterface())
 		{
-			FOnlineSessionSettings SessionSettings = GetSessionSettings();
-			OnlineSessionPtr->UpdateSession(DEFAULT_SESSION_NAME, SessionSettings, true);
+			OnlineSessionPtr->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteHandle);
 		}
 	}
+
+	bSessionAdvertisementUpdateInFlight = false;
+
+	if (!bWasSuccessful)
+	{
+		UE_LOG(LogECR, Warning, TEXT("Failed to update advertised session settings, retrying"));
+		bSessionAdvertisementDirty = true;
+	}
+
+	if (bSessionAdvertisementDirty)
+	{
+		UpdateSessionSettings();
+	}
 }
 
 void UECRGameInstance::UpdateSessionCurrentPlayerAmount(const int32 NewPlayerAmount)
 {
-	MatchCreationSettings.CurrentPlayerAmount = NewPlayerAmount;
-	UpdateSessionSettings();
+	if (MatchCreationSettings.CurrentPlayerAmount != NewPlayerAmount)
+	{
+		MatchCreationSettings.CurrentPlayerAmount = NewPlayerAmount;
+		UpdateSessionSettings();
+	}
 }
 
 void UECRGameInstance::UpdateSessionMatchStartedTimestamp(const double NewTimestamp)
 {
-	MatchCreationSettings.MatchStartedTime = NewTimestamp;
-	UpdateSessionSettings();
+	if (MatchCreationSettings.MatchStartedTime != NewTimestamp)
+	{
+		MatchCreationSettings.MatchStartedTime = NewTimestamp;
+		UpdateSessionSettings();
+	}
 }
 
 void UECRGameInstance::UpdateSessionDayTime(const FName NewDayTime)
 {
-	MatchCreationSettings.DayTimeName = NewDayTime;
-	UpdateSessionSettings();
+	if (MatchCreationSettings.DayTimeName != NewDayTime)
+	{
+		MatchCreationSettings.DayTimeName = NewDayTime;
+		UpdateSessionSettings();
+	}
 }
 
 
@@ -312,24 +441,11 @@ void UECRGameInstance::OnCreateMatchComplete(FName SessionName, const bool bWasS
 
 void UECRGameInstance::OnFindMatchesComplete(const bool bWasSuccessful)
 {
-	if (OnlineSubsystem)
-	{
-		if (const IOnlineSessionPtr OnlineSessionPtr = OnlineSubsystem->GetSessionInterface())
-		{
-			OnlineSessionPtr->ClearOnFindSessionsCompleteDelegates(this);
-		}
-	}
-
 	if (AECRGUIPlayerController* GUISupervisor = UECRUtilsLibrary::GetGUISupervisor(GetWorld()))
 	{
 		if (bWasSuccessful)
 		{
-			TArray<FECRMatchResult> SessionResults;
-			for (const FOnlineSessionSearchResult& SessionResult : SessionSearchSettings->SearchResults)
-			{
-				SessionResults.Add(FECRMatchResult{FBlueprintSessionResult{SessionResult}});
-			}
-			GUISupervisor->HandleFindMatchesSuccess(SessionResults);
+			GUISupervisor->HandleFindMatchesSuccess(SessionBrowser->GetResults());
 		}
 		else
 		{
@@ -409,44 +525,20 @@ FOnlineSessionSettings UECRGameInstance::GetSessionSettings()
 	SessionSettings.bUsesPresence = !bIsDedicatedServer;
 
 	/** Custom settings **/
-	SessionSettings.Set(SETTING_GAMEMODE, MatchCreationSettings.GameMode.ToString(),
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_MAPNAME, MatchCreationSettings.MapName.ToString(),
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_GAME_MISSION, MatchCreationSettings.GameMission.ToString(),
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_USER_DISPLAY_NAME, UserDisplayName,
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_GAME_VERSION, MatchCreationSettings.GameVersion,
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_WEATHER_NAME, MatchCreationSettings.WeatherName.ToString(),
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_DAYTIME_NAME, MatchCreationSettings.DayTimeName.ToString(),
-						EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_REGION, MatchCreationSettings.Region.ToString(),
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-
-	// Set boolean flags for filtering by participating factions, set string flag for info about sides
-	for (auto [FactionNames, Strength] : MatchCreationSettings.Alliances)
-	{
-		for (FName FactionName : FactionNames)
-		{
-			SessionSettings.Set(FName{SETTING_FACTION_PREFIX.ToString() + FactionName.ToString()}, true,
-			                    EOnlineDataAdvertisementType::ViaOnlineService);
-		}
-	}
-
-	FString FactionsString = GetMatchFactionString(MatchCreationSettings.Alliances,
-	                                               MatchCreationSettings.FactionNamesToShortTexts);
-	SessionSettings.Set(SETTING_FACTIONS, FactionsString, EOnlineDataAdvertisementType::ViaOnlineService);
-
-
-	// Real updatable values
-	const FString PlayerAmountString = FString::FromInt(MatchCreationSettings.CurrentPlayerAmount);
-	SessionSettings.Set(SETTING_CURRENT_PLAYER_AMOUNT, PlayerAmountString,
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_STARTED_TIME, MatchCreationSettings.MatchStartedTime,
-	                    EOnlineDataAdvertisementType::ViaOnlineService);
+	FECRMatchAdvertisement Advertisement;
+	Advertisement.GameVersion = MatchCreationSettings.GameVersion;
+	Advertisement.GameMode = MatchCreationSettings.GameMode;
+	Advertisement.MapName = MatchCreationSettings.MapName;
+	Advertisement.GameMission = MatchCreationSettings.GameMission;
+	Advertisement.Region = MatchCreationSettings.Region;
+	Advertisement.WeatherName = MatchCreationSettings.WeatherName;
+	Advertisement.DayTimeName = MatchCreationSettings.DayTimeName;
+	Advertisement.UserDisplayName = UserDisplayName;
+	Advertisement.Alliances = MatchCreationSettings.Alliances;
+	Advertisement.FactionNamesToShortTexts = MatchCreationSettings.FactionNamesToShortTexts;
+	Advertisement.CurrentPlayerAmount = MatchCreationSettings.CurrentPlayerAmount;
+	Advertisement.MatchStartedTime = MatchCreationSettings.MatchStartedTime;
+	Advertisement.Write(SessionSettings);
 
 	/** Custom settings end */
 
@@ -478,5 +570,8 @@ void UECRGameInstance::Init()
 
 void UECRGameInstance::Shutdown()
 {
+	SessionBrowser.Reset();
+	FTSTicker::GetCoreTicker().RemoveTicker(SessionAdvertisementTickerHandle);
+
 	Super::Shutdown();
 }
@@ -0,0 +1,308 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/ECRServerStatsSubsystem.h"
+#include "System/ECRLogChannels.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "ServerCosmeticsFilter.h"
+
+namespace ECRServerStats
+{
+	static int32 EnableOnListenServer = 0;
+	static FAutoConsoleVariableRef CVarEnableOnListenServer(
+		TEXT("ECR.ServerStats.EnableOnListenServer"),
+		EnableOnListenServer,
+		TEXT("Also run the server stats profiler on listen servers (always on for dedicated servers). Read on game instance start, only listen server worlds are recorded."),
+		ECVF_Default);
+
+	static float FlushInterval = 30.f;
+	static FAutoConsoleVariableRef CVarFlushInterval(
+		TEXT("ECR.ServerStats.FlushInterval"),
+		FlushInterval,
+		TEXT("Seconds between server stats summaries"),
+		ECVF_Default);
+
+	static int32 LoopbackPort = 0;
+	static FAutoConsoleVariableRef CVarLoopbackPort(
+		TEXT("ECR.ServerStats.LoopbackPort"),
+		LoopbackPort,
+		TEXT("If non-zero, server stats summaries are also sent as UDP datagrams to 127.0.0.1 on this port"),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdFlush(
+		TEXT("ECR.ServerStats.Flush"),
+		TEXT("Writes the current server stats summaries immediately"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			if (UECRServerStatsSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UECRServerStatsSubsystem>() : nullptr)
+			{
+				Subsystem->Flush();
+			}
+		}));
+
+	static int32 FrameScope = INDEX_NONE;
+	static int32 ReplicationScope = INDEX_NONE;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void FECRServerStatHistogram::Add(double Microseconds)
+{
+	const int32 Bucket = Microseconds <= 1.0
+		                     ? 0
+		                     : FMath::Min(FMath::FloorToInt(FMath::Log2(Microseconds) * BucketsPerOctave) + 1, NumBuckets - 1);
+	Buckets[Bucket]++;
+	Count++;
+	TotalMicroseconds += Microseconds;
+	MaxMicroseconds = FMath::Max(MaxMicroseconds, Microseconds);
+}
+
+void FECRServerStatHistogram::Reset()
+{
+	*this = FECRServerStatHistogram();
+}
+
+double FECRServerStatHistogram::GetPercentile(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint32 Rank = FMath::Max<uint32>(FMath::CeilToInt(Percentile * Count), 1);
+	uint32 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Rank)
+		{
+			const double UpperBound = FMath::Pow(2.0, static_cast<double>(Bucket) / BucketsPerOctave);
+			return FMath::Min(UpperBound, MaxMicroseconds);
+		}
+	}
+
+	return MaxMicroseconds;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+bool FECRServerStats::bEnabled = false;
+
+TArray<FECRServerStats::FScope>& FECRServerStats::GetScopes()
+{
+	static TArray<FScope> Scopes;
+	return Scopes;
+}
+
+int32 FECRServerStats::RegisterScope(const TCHAR* Name)
+{
+	TArray<FScope>& Scopes = GetScopes();
+
+	const int32 ExistingIndex = Scopes.IndexOfByPredicate([Name](const FScope& Scope) { return Scope.Name == Name; });
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	FScope& Scope = Scopes.AddDefaulted_GetRef();
+	Scope.Name = Name;
+	return Scopes.Num() - 1;
+}
+
+void FECRServerStats::Record(int32 ScopeIndex, double Microseconds)
+{
+	// Histograms aren't synchronized, the server hot paths we care about all run on the game thread
+	if (bEnabled && IsInGameThread())
+	{
+		GetScopes()[ScopeIndex].Histogram.Add(Microseconds);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+bool UECRServerStatsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// The net mode isn't known yet on a listen server build, recording is gated on it per world tick
+	return IsRunningDedicatedServer() || ECRServerStats::EnableOnListenServer != 0;
+}
+
+void UECRServerStatsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ECRServerStats::FrameScope = FECRServerStats::RegisterScope(TEXT("Frame"));
+	ECRServerStats::ReplicationScope = FECRServerStats::RegisterScope(TEXT("Replication"));
+
+	OutputFilePath = FPaths::ProfilingDir() / TEXT("ServerStats") /
+		FString::Printf(TEXT("ServerStats-%s.csv"), *FDateTime::Now().ToString());
+
+	LoopbackPort = ECRServerStats::LoopbackPort;
+	if (LoopbackPort > 0)
+	{
+		LoopbackSocket = FUdpSocketBuilder(TEXT("ECRServerStats")).AsNonBlocking().Build();
+	}
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &ThisClass::HandleWorldTickStart);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HandleTicker), 1.f);
+
+	LastFlushTime = FPlatformTime::Seconds();
+	FECRServerStats::bEnabled = IsRunningDedicatedServer();
+
+	UE_LOG(LogECR, Log, TEXT("Server stats profiler writing to %s"), *OutputFilePath);
+}
+
+void UECRServerStatsSubsystem::Deinitialize()
+{
+	Flush();
+	FECRServerStats::bEnabled = false;
+
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	if (UWorld* World = PostTickFlushWorld.Get())
+	{
+		World->OnPostTickFlush().Remove(PostTickFlushHandle);
+	}
+
+	if (LoopbackSocket)
+	{
+		LoopbackSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(LoopbackSocket);
+		LoopbackSocket = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UECRServerStatsSubsystem::HandleTicker(float DeltaTime)
+{
+	if (FPlatformTime::Seconds() - LastFlushTime >= ECRServerStats::FlushInterval)
+	{
+		Flush();
+	}
+	return true;
+}
+
+void UECRServerStatsSubsystem::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	// The game instance world changes on travel, follow it
+	if (PostTickFlushWorld.Get() != World)
+	{
+		if (UWorld* OldWorld = PostTickFlushWorld.Get())
+		{
+			OldWorld->OnPostTickFlush().Remove(PostTickFlushHandle);
+		}
+		PostTickFlushHandle = World->OnPostTickFlush().AddUObject(this, &ThisClass::HandlePostTickFlush);
+		PostTickFlushWorld = World;
+	}
+
+	// Only record while this game instance is serving, not while it's connected to a server or in the menus
+	const ENetMode NetMode = World->GetNetMode();
+	FECRServerStats::bEnabled = NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+
+	FrameStartCycles = FPlatformTime::Cycles64();
+	ReplicationStartCycles = 0;
+}
+
+void UECRServerStatsSubsystem::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == PostTickFlushWorld.Get())
+	{
+		ReplicationStartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+void UECRServerStatsSubsystem::HandlePostTickFlush(float DeltaSeconds)
+{
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+
+	// Work time of the frame, the wait for the next server tick isn't included
+	if (FrameStartCycles != 0)
+	{
+		FECRServerStats::Record(ECRServerStats::FrameScope, FPlatformTime::ToMilliseconds64(NowCycles - FrameStartCycles) * 1000.0);
+	}
+
+	if (ReplicationStartCycles != 0)
+	{
+		FECRServerStats::Record(ECRServerStats::ReplicationScope, FPlatformTime::ToMilliseconds64(NowCycles - ReplicationStartCycles) * 1000.0);
+	}
+}
+
+void UECRServerStatsSubsystem::Flush()
+{
+	LastFlushTime = FPlatformTime::Seconds();
+
+	const FString Time = FDateTime::UtcNow().ToIso8601();
+	FString Summary;
+
+	for (FECRServerStats::FScope& Scope : FECRServerStats::GetScopes())
+	{
+		const FECRServerStatHistogram& Histogram = Scope.Histogram;
+		if (Histogram.Count == 0)
+		{
+			continue;
+		}
+
+		Summary += FString::Printf(TEXT("%s,%s,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n"),
+		                           *Time, *Scope.Name, Histogram.Count,
+		                           Histogram.TotalMicroseconds / Histogram.Count,
+		                           Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9),
+		                           Histogram.GetPercentile(0.99), Histogram.MaxMicroseconds);
+		Scope.Histogram.Reset();
+	}
+
+	// Cosmetic work skipped in this window, only the count column applies
+	TMap<FName, int64> SkippedCounts;
+	FServerCosmeticsFilter::ConsumeSkippedCounts(SkippedCounts);
+	for (const TPair<FName, int64>& SkippedCount : SkippedCounts)
+	{
+		Summary += FString::Printf(TEXT("%s,CosmeticsSkipped.%s,%lld,0,0,0,0,0\n"),
+		                           *Time, *SkippedCount.Key.ToString(), SkippedCount.Value);
+	}
+
+	if (Summary.IsEmpty())
+	{
+		return;
+	}
+
+	if (!IFileManager::Get().FileExists(*OutputFilePath))
+	{
+		Summary = TEXT("Time,Scope,Count,AvgUs,P50Us,P90Us,P99Us,MaxUs\n") + Summary;
+	}
+
+	FFileHelper::SaveStringToFile(Summary, *OutputFilePath, FFileHelper::EEncodingOptions::AutoDetect,
+	                              &IFileManager::Get(), FILEWRITE_Append);
+
+	SendToLoopback(Summary);
+}
+
+void UECRServerStatsSubsystem::SendToLoopback(const FString& Text)
+{
+	if (LoopbackSocket == nullptr)
+	{
+		return;
+	}
+
+	const TSharedRef<FInternetAddr> Address = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+	Address->SetIp(FIPv4Address::InternalLoopback.Value);
+	Address->SetPort(LoopbackPort);
+
+	const FTCHARToUTF8 Utf8(*Text);
+	int32 BytesSent = 0;
+	LoopbackSocket->SendTo(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), BytesSent, *Address);
+}
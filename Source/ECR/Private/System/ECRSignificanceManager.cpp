@@ -1,3 +1,283 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "System/ECRSignificanceManager.h"
+#include "System/ECRLogChannels.h"
+#include "Animation/ECRAnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Containers/Ticker.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+const FName UECRSignificanceManager::CharacterTag(TEXT("Character"));
+
+namespace ECRSignificance
+{
+	struct FAnimUpdateRateTestCase
+	{
+		float DistanceFraction = 0.f;
+		bool bRendered = true;
+		int32 UpdateRate = 1;
+		int32 StartUpdateCount = 0;
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<UECRAnimInstance> AnimInstance;
+	};
+
+	static void FinishAnimUpdateRateTest(const bool bPassed, const bool bExitWhenDone)
+	{
+		UE_LOG(LogECR, Log, TEXT("Anim update rate test %s"), bPassed ? TEXT("passed") : TEXT("failed"));
+
+		if (bExitWhenDone)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+		}
+	}
+
+	// Check of the configured animation update rates on real meshes, meant to run headless. Run with
+	//   ECR.Significance.TestAnimUpdateRates [Frames=N] [Mesh=<skeletal mesh>] [ExitWhenDone]
+	// A mesh with an UECRAnimInstance is spawned per fixed distance, rendered and not, and given the rate its
+	// significance maps to. After ticking with the world, NativeUpdateAnimation calls must match the rate, must not
+	// rise when the character isn't rendered and must be zero beyond the significance distance. Nothing renders
+	// headless, so every mesh takes the not rendered path, which SetAnimUpdateRate sets to the same rate as LODs.
+	static void TestAnimUpdateRates(const TArray<FString>& Args, UWorld* World)
+	{
+		const FString CommandLine = FString::Join(Args, TEXT(" "));
+
+		int32 Frames = 600;
+		FParse::Value(*CommandLine, TEXT("Frames="), Frames);
+		Frames = FMath::Max(Frames, 1);
+
+		FString MeshPath = TEXT("/Engine/EngineMeshes/SkeletalCube.SkeletalCube");
+		FParse::Value(*CommandLine, TEXT("Mesh="), MeshPath);
+
+		const bool bExitWhenDone = Args.Contains(TEXT("ExitWhenDone"));
+
+		USkeletalMesh* SkeletalMesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
+		if (World == nullptr || SkeletalMesh == nullptr)
+		{
+			UE_LOG(LogECR, Error, TEXT("Anim update rate test needs a game world and skeletal mesh %s"), *MeshPath);
+			FinishAnimUpdateRateTest(false, bExitWhenDone);
+			return;
+		}
+
+		const UECRSignificanceManager* SignificanceManager = GetDefault<UECRSignificanceManager>();
+		const float DistanceFractions[] = {0.f, 0.2f, 0.4f, 0.6f, 0.8f, 0.95f, 1.05f};
+
+		TSharedRef<TArray<FAnimUpdateRateTestCase>> Cases = MakeShared<TArray<FAnimUpdateRateTestCase>>();
+		for (const bool bRendered : {true, false})
+		{
+			for (const float DistanceFraction : DistanceFractions)
+			{
+				FAnimUpdateRateTestCase& Case = Cases->AddDefaulted_GetRef();
+				Case.DistanceFraction = DistanceFraction;
+				Case.bRendered = bRendered;
+
+				const FVector Location(SignificanceManager->GetMaxSignificanceDistance() * DistanceFraction,
+				                       bRendered ? 0.f : 1000.f, 0.f);
+				Case.UpdateRate = SignificanceManager->GetAnimUpdateRate(
+					SignificanceManager->CalculateCharacterSignificance(Location, bRendered, FTransform::Identity));
+
+				FActorSpawnParameters SpawnInfo;
+				SpawnInfo.ObjectFlags |= RF_Transient;
+				SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location), SpawnInfo);
+
+				USkeletalMeshComponent* Mesh = NewObject<USkeletalMeshComponent>(Actor);
+				Mesh->bEnableUpdateRateOptimizations = true;
+				Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+				Mesh->SetSkeletalMesh(SkeletalMesh);
+				Mesh->SetAnimInstanceClass(UECRAnimInstance::StaticClass());
+				Actor->SetRootComponent(Mesh);
+				Mesh->RegisterComponent();
+
+				Case.Actor = Actor;
+				Case.AnimInstance = Cast<UECRAnimInstance>(Mesh->GetAnimInstance());
+				if (Case.AnimInstance.IsValid())
+				{
+					Case.AnimInstance->SetAnimUpdateRate(Case.UpdateRate);
+					Case.StartUpdateCount = Case.AnimInstance->GetNumNativeUpdates();
+				}
+			}
+		}
+
+		TSharedRef<int32> FramesLeft = MakeShared<int32>(Frames);
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+			[Cases, FramesLeft, Frames, bExitWhenDone](float)
+			{
+				if (--(*FramesLeft) > 0)
+				{
+					return true;
+				}
+
+				// Skipped frames are phased per actor, so the first and last update can fall either side of the window
+				const int32 Tolerance = 2;
+
+				// Not rendered cases follow the rendered ones at the same distances
+				const int32 NumPerPass = Cases->Num() / 2;
+
+				bool bPassed = true;
+				for (int32 Index = 0; Index < Cases->Num(); ++Index)
+				{
+					const FAnimUpdateRateTestCase& Case = (*Cases)[Index];
+					const int32 UpdateCount = Case.AnimInstance.IsValid()
+						                          ? Case.AnimInstance->GetNumNativeUpdates() - Case.StartUpdateCount
+						                          : INDEX_NONE;
+					const int32 ExpectedCount = Case.UpdateRate > 0 ? Frames / Case.UpdateRate : 0;
+
+					const FAnimUpdateRateTestCase* RenderedCase = Case.bRendered ? nullptr : &(*Cases)[Index - NumPerPass];
+					const int32 RenderedUpdateCount = RenderedCase && RenderedCase->AnimInstance.IsValid()
+						                                  ? RenderedCase->AnimInstance->GetNumNativeUpdates() - RenderedCase->StartUpdateCount
+						                                  : MAX_int32;
+
+					const bool bBeyondDistance = Case.DistanceFraction > 1.f;
+					const bool bValid = UpdateCount != INDEX_NONE
+						&& FMath::Abs(UpdateCount - ExpectedCount) <= Tolerance
+						&& (!bBeyondDistance || UpdateCount == 0)
+						&& (Case.bRendered || UpdateCount <= RenderedUpdateCount + Tolerance);
+
+					UE_LOG(LogECR, Log, TEXT("Anim update rate test: distance %.2f, rendered %d, rate %d, %d/%d updates (expected %d)%s"),
+					       Case.DistanceFraction, Case.bRendered, Case.UpdateRate, UpdateCount, Frames, ExpectedCount,
+					       bValid ? TEXT("") : TEXT(" FAILED"));
+
+					bPassed &= bValid;
+				}
+
+				for (const FAnimUpdateRateTestCase& Case : *Cases)
+				{
+					if (AActor* Actor = Case.Actor.Get())
+					{
+						Actor->Destroy();
+					}
+				}
+
+				FinishAnimUpdateRateTest(bPassed, bExitWhenDone);
+				return false;
+			}));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdTestAnimUpdateRates(
+		TEXT("ECR.Significance.TestAnimUpdateRates"),
+		TEXT("Ticks meshes at fixed distances and checks their animation updates against configured rates. Usage: ECR.Significance.TestAnimUpdateRates [Frames=600] [Mesh=<skeletal mesh>] [ExitWhenDone]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(TestAnimUpdateRates));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+UECRSignificanceManager::UECRSignificanceManager()
+{
+	AnimUpdateRateThresholds = {
+		{0.75f, 1},
+		{0.5f, 2},
+		{0.25f, 3},
+		{0.f, 4}
+	};
+}
+
+void UECRSignificanceManager::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
+	}
+}
+
+void UECRSignificanceManager::BeginDestroy()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Super::BeginDestroy();
+}
+
+void UECRSignificanceManager::RegisterCharacter(ACharacter* Character)
+{
+	check(Character);
+
+	// Evaluated in parallel, only reads state of the character
+	auto SignificanceFunction = [this](const FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+	{
+		const ACharacter* ManagedCharacter = CastChecked<ACharacter>(ObjectInfo->GetObject());
+		const USkeletalMeshComponent* MeshComp = ManagedCharacter->GetMesh();
+		return CalculateCharacterSignificance(ManagedCharacter->GetActorLocation(),
+		                                      MeshComp && MeshComp->WasRecentlyRendered(RecentlyRenderedTolerance),
+		                                      Viewpoint);
+	};
+
+	auto PostSignificanceFunction = [this](const FManagedObjectInfo* ObjectInfo, float OldSignificance,
+	                                       const float Significance, bool bFinal)
+	{
+		const ACharacter* ManagedCharacter = CastChecked<ACharacter>(ObjectInfo->GetObject());
+		const USkeletalMeshComponent* MeshComp = ManagedCharacter->GetMesh();
+		if (UECRAnimInstance* AnimInstance = MeshComp ? Cast<UECRAnimInstance>(MeshComp->GetAnimInstance()) : nullptr)
+		{
+			// Only simulated poses are cosmetic, a possessed character drives its own root motion
+			const bool bSimulated = ManagedCharacter->GetLocalRole() == ROLE_SimulatedProxy;
+			AnimInstance->SetAnimUpdateRate(bSimulated ? GetAnimUpdateRate(Significance) : 1);
+		}
+	};
+
+	RegisterObject(Character, CharacterTag, SignificanceFunction, EPostSignificanceType::Sequential,
+	               PostSignificanceFunction);
+}
+
+float UECRSignificanceManager::CalculateCharacterSignificance(const FVector& CharacterLocation,
+                                                              const bool bRecentlyRendered,
+                                                              const FTransform& Viewpoint) const
+{
+	const float Distance = FVector::Dist(CharacterLocation, Viewpoint.GetLocation());
+	const float DistanceSignificance = 1.f - Distance / FMath::Max(MaxSignificanceDistance, 1.f);
+	if (DistanceSignificance <= 0.f)
+	{
+		return 0.f;
+	}
+
+	return bRecentlyRendered ? DistanceSignificance : DistanceSignificance * NotRenderedSignificanceScale;
+}
+
+int32 UECRSignificanceManager::GetAnimUpdateRate(const float Significance) const
+{
+	if (Significance <= 0.f)
+	{
+		return 0;
+	}
+
+	for (const FECRAnimUpdateRateThreshold& Threshold : AnimUpdateRateThresholds)
+	{
+		if (Significance >= Threshold.MinSignificance)
+		{
+			return FMath::Max(Threshold.UpdateRate, 1);
+		}
+	}
+
+	return AnimUpdateRateThresholds.Num() > 0 ? FMath::Max(AnimUpdateRateThresholds.Last().UpdateRate, 1) : 1;
+}
+
+void UECRSignificanceManager::HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld())
+	{
+		return;
+	}
+
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator It = InWorld->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Viewpoints.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	// Nothing to rate against on dedicated servers or before local players exist
+	if (Viewpoints.Num() > 0)
+	{
+		Update(Viewpoints);
+	}
+}
@@ -26,6 +26,14 @@ public:
 
 	virtual void InitializeWithAbilitySystem(UAbilitySystemComponent* ASC);
 
+	/** Set frames between animation updates, driven by significance. 0 stops updates but keeps tag bindings */
+	void SetAnimUpdateRate(int32 UpdateRate);
+
+	int32 GetAnimUpdateRate() const { return AnimUpdateRate; }
+
+	/** Calls of NativeUpdateAnimation so far, for checking update rates */
+	int32 GetNumNativeUpdates() const { return NumNativeUpdates; }
+
 protected:
 
 #if WITH_EDITOR
@@ -46,4 +54,10 @@ protected:
 
 	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
 	float GroundDistance = -1.0f;
+
+private:
+	// Unset until the first SetAnimUpdateRate, so a rate of 1 still configures the mesh
+	int32 AnimUpdateRate = INDEX_NONE;
+
+	int32 NumNativeUpdates = 0;
 };
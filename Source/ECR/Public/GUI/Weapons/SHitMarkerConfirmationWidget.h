@@ -12,6 +12,8 @@
 #include "GameplayTagContainer.h"
 
 struct FLocalPlayerContext;
+struct FECRScreenSpaceHitLocation;
+class UECRWeaponStateComponent;
 
 class SHitMarkerConfirmationWidget : public SLeafWidget
 {
@@ -54,6 +56,18 @@ public:
 	//~End of SWidget interface
 
 private:
+	UECRWeaponStateComponent* GetWeaponStateComponent();
+
+	/** Projects the world space hit locations of the weapon state component to the screen in one batch */
+	void ProjectHitLocations(const TArray<FECRScreenSpaceHitLocation>& HitLocations);
+
+private:
+	/** Hit markers projected to viewport screenspace during Tick, drawn in OnPaint */
+	TArray<FECRScreenSpaceHitLocation> ProjectedHitLocations;
+
+	/** Weapon state component of the owning player controller */
+	TWeakObjectPtr<UECRWeaponStateComponent> CachedWeaponStateComponent;
+
 	/** The marker image to draw for non penetration. */
 	const FSlateBrush* NonPenetrationMarkerImage = nullptr;
 	
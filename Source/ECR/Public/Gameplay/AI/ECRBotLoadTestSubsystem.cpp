@@ -0,0 +1,327 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ECRBotLoadTestSubsystem.h"
+#include "ECRPlayerBotController.h"
+#include "Gameplay/ECRGameMode.h"
+#include "System/ECRLogChannels.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ECRBotLoadTest
+{
+	static int32 QuitWhenDone = 0;
+	static FAutoConsoleVariableRef CVarQuitWhenDone(
+		TEXT("ECR.LoadTest.QuitWhenDone"),
+		QuitWhenDone,
+		TEXT("Request engine exit once a load test has written its results (for unattended runs)"),
+		ECVF_Default);
+
+	static void StartLoadTest(const TArray<FString>& Args, UWorld* World)
+	{
+		UECRBotLoadTestSubsystem* Subsystem = World ? World->GetSubsystem<UECRBotLoadTestSubsystem>() : nullptr;
+		if (Subsystem == nullptr)
+		{
+			UE_LOG(LogECR, Warning, TEXT("ECR.LoadTest.Start can only run on a server world"));
+			return;
+		}
+
+		const int32 MaxBots = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 32;
+		const int32 BotsPerStep = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 4;
+		const float StepDuration = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 20.f;
+
+		Subsystem->StartLoadTest(MaxBots, BotsPerStep, StepDuration);
+	}
+
+	static void StopLoadTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (UECRBotLoadTestSubsystem* Subsystem = World ? World->GetSubsystem<UECRBotLoadTestSubsystem>() : nullptr)
+		{
+			Subsystem->StopLoadTest();
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdStartLoadTest(
+		TEXT("ECR.LoadTest.Start"),
+		TEXT("Runs a stepped bot load test. Usage: ECR.LoadTest.Start [MaxBots=32] [BotsPerStep=4] [StepSeconds=20]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(StartLoadTest));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdStopLoadTest(
+		TEXT("ECR.LoadTest.Stop"),
+		TEXT("Stops the running bot load test and writes the results measured so far"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(StopLoadTest));
+}
+
+UECRBotLoadTestSubsystem::UECRBotLoadTestSubsystem()
+{
+}
+
+bool UECRBotLoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Bots only exist on the server
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+void UECRBotLoadTestSubsystem::Deinitialize()
+{
+	if (bRunning)
+	{
+		StopLoadTest();
+	}
+
+	Super::Deinitialize();
+}
+
+void UECRBotLoadTestSubsystem::StartLoadTest(int32 MaxBots, int32 BotsPerStep, float StepDuration)
+{
+	if (bRunning)
+	{
+		UE_LOG(LogECR, Warning, TEXT("Bot load test is already running"));
+		return;
+	}
+
+	if (GetWorld()->GetAuthGameMode<AECRGameMode>() == nullptr)
+	{
+		UE_LOG(LogECR, Warning, TEXT("Bot load test requires an ECR game mode"));
+		return;
+	}
+
+	TargetMaxBots = FMath::Max(MaxBots, 1);
+	TargetBotsPerStep = FMath::Clamp(BotsPerStep, 1, TargetMaxBots);
+	TargetStepDuration = FMath::Max(StepDuration, 1.f);
+	Results.Reset();
+	bRunning = true;
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &ThisClass::HandleWorldTickStart);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
+	PostTickFlushHandle = GetWorld()->OnPostTickFlush().AddUObject(this, &ThisClass::HandlePostTickFlush);
+
+	UE_LOG(LogECR, Log, TEXT("Bot load test started: up to %d bots, %d per step, %.1fs per step"),
+	       TargetMaxBots, TargetBotsPerStep, TargetStepDuration);
+
+	BeginStep();
+}
+
+void UECRBotLoadTestSubsystem::StopLoadTest()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	bSampling = false;
+
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	GetWorld()->OnPostTickFlush().Remove(PostTickFlushHandle);
+
+	WriteResults();
+	DestroyBots();
+
+	if (ECRBotLoadTest::QuitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void UECRBotLoadTestSubsystem::HandleWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		FrameStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UECRBotLoadTestSubsystem::HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	// Everything between here and the end of TickFlush is net driver work, mostly replication
+	if (InWorld == GetWorld())
+	{
+		ReplicationStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UECRBotLoadTestSubsystem::HandlePostTickFlush(float DeltaSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (!bSampling)
+	{
+		if (Now - StepStartTime >= StepWarmupDuration)
+		{
+			bSampling = true;
+			StepStartTime = Now;
+			LastMemorySampleTime = 0.0;
+		}
+		return;
+	}
+
+	// Measures work done in the frame, not the idle wait for the next server tick
+	const double FrameMs = (Now - FrameStartTime) * 1000.0;
+	const double ReplicationMs = (Now - ReplicationStartTime) * 1000.0;
+
+	CurrentStep.NumFrames++;
+	TotalFrameMs += FrameMs;
+	TotalReplicationMs += ReplicationMs;
+	CurrentStep.MaxFrameMs = FMath::Max(CurrentStep.MaxFrameMs, FrameMs);
+	CurrentStep.MaxReplicationMs = FMath::Max(CurrentStep.MaxReplicationMs, ReplicationMs);
+
+	// Reading memory stats is not free on every platform, once a second is plenty
+	if (Now - LastMemorySampleTime >= 1.0)
+	{
+		LastMemorySampleTime = Now;
+		const uint64 UsedPhysicalMB = FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024);
+		CurrentStep.UsedPhysicalMB = UsedPhysicalMB;
+		CurrentStep.PeakUsedPhysicalMB = FMath::Max(CurrentStep.PeakUsedPhysicalMB, UsedPhysicalMB);
+	}
+
+	if (Now - StepStartTime >= TargetStepDuration)
+	{
+		FinishStep();
+	}
+}
+
+void UECRBotLoadTestSubsystem::BeginStep()
+{
+	SpawnBots(FMath::Min(TargetBotsPerStep, TargetMaxBots - SpawnedBots.Num()));
+	if (!bRunning)
+	{
+		return;
+	}
+
+	CurrentStep = FECRBotLoadTestStepResult();
+	CurrentStep.BotCount = SpawnedBots.Num();
+	TotalFrameMs = 0.0;
+	TotalReplicationMs = 0.0;
+	StepStartTime = FPlatformTime::Seconds();
+	bSampling = false;
+}
+
+void UECRBotLoadTestSubsystem::FinishStep()
+{
+	if (CurrentStep.NumFrames > 0)
+	{
+		CurrentStep.AverageFrameMs = TotalFrameMs / CurrentStep.NumFrames;
+		CurrentStep.AverageReplicationMs = TotalReplicationMs / CurrentStep.NumFrames;
+	}
+
+	UE_LOG(LogECR, Log, TEXT("Bot load test step: %d bots, frame %.2fms avg / %.2fms max, replication %.2fms avg, %llu MB used"),
+	       CurrentStep.BotCount, CurrentStep.AverageFrameMs, CurrentStep.MaxFrameMs,
+	       CurrentStep.AverageReplicationMs, CurrentStep.UsedPhysicalMB);
+
+	Results.Add(CurrentStep);
+
+	// Bots that failed to spawn would make the test loop forever, so stop on a step that added nothing
+	const bool bNoProgress = Results.Num() > 1 && Results.Last(1).BotCount == CurrentStep.BotCount;
+	if (SpawnedBots.Num() >= TargetMaxBots || bNoProgress)
+	{
+		StopLoadTest();
+	}
+	else
+	{
+		BeginStep();
+	}
+}
+
+void UECRBotLoadTestSubsystem::SpawnBots(int32 NumBots)
+{
+	UWorld* World = GetWorld();
+	AECRGameMode* GameMode = World->GetAuthGameMode<AECRGameMode>();
+	if (GameMode == nullptr)
+	{
+		return;
+	}
+
+	UClass* ControllerClass = BotControllerClass.IsNull()
+		                          ? AECRPlayerBotController::StaticClass()
+		                          : BotControllerClass.LoadSynchronous();
+
+	// Bots without these would only walk around, the results would not represent a match
+	const AECRPlayerBotController* ControllerCDO = ControllerClass
+		                                               ? GetDefault<AECRPlayerBotController>(ControllerClass)
+		                                               : nullptr;
+	if (ControllerCDO == nullptr || !ControllerCDO->HasValidLoadTestInputTags())
+	{
+		UE_LOG(LogECR, Error, TEXT("Bot load test stopped: %s has no valid load-test fire and interact input tags"),
+		       *GetNameSafe(ControllerClass));
+		StopLoadTest();
+		return;
+	}
+
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnInfo.OverrideLevel = World->PersistentLevel;
+		SpawnInfo.ObjectFlags |= RF_Transient;
+
+		AECRPlayerBotController* Bot = World->SpawnActor<AECRPlayerBotController>(ControllerClass, SpawnInfo);
+		if (Bot == nullptr)
+		{
+			UE_LOG(LogECR, Warning, TEXT("Bot load test failed to spawn a bot controller"));
+			continue;
+		}
+
+		GameMode->GenericPlayerInitialization(Bot);
+		if (Bot->PlayerState)
+		{
+			Bot->PlayerState->SetPlayerName(FString::Printf(TEXT("LoadTestBot%d"), SpawnedBots.Num()));
+		}
+		GameMode->RestartPlayer(Bot);
+
+		Bot->SetLoadTestBehaviorEnabled(true);
+		SpawnedBots.Add(Bot);
+	}
+}
+
+void UECRBotLoadTestSubsystem::DestroyBots()
+{
+	for (AECRPlayerBotController* Bot : SpawnedBots)
+	{
+		if (IsValid(Bot))
+		{
+			Bot->SetLoadTestBehaviorEnabled(false);
+			if (APawn* BotPawn = Bot->GetPawn())
+			{
+				BotPawn->Destroy();
+			}
+			Bot->Destroy();
+		}
+	}
+
+	SpawnedBots.Reset();
+}
+
+void UECRBotLoadTestSubsystem::WriteResults() const
+{
+	if (Results.Num() == 0)
+	{
+		return;
+	}
+
+	FString Csv = TEXT("Bots,Frames,AvgFrameMs,MaxFrameMs,AvgReplicationMs,MaxReplicationMs,UsedPhysicalMB,PeakUsedPhysicalMB\n");
+	for (const FECRBotLoadTestStepResult& Step : Results)
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f,%.3f,%llu,%llu\n"),
+		                       Step.BotCount, Step.NumFrames, Step.AverageFrameMs, Step.MaxFrameMs,
+		                       Step.AverageReplicationMs, Step.MaxReplicationMs,
+		                       Step.UsedPhysicalMB, Step.PeakUsedPhysicalMB);
+	}
+
+	const FString FilePath = FPaths::ProfilingDir() / TEXT("LoadTest") /
+		FString::Printf(TEXT("BotLoadTest-%s-%s.csv"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogECR, Log, TEXT("Bot load test results written to %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogECR, Error, TEXT("Failed to write bot load test results to %s"), *FilePath);
+	}
+}
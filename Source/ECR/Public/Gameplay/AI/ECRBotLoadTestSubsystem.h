@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ECRBotLoadTestSubsystem.generated.h"
+
+class AECRPlayerBotController;
+
+/** Aggregated server measurements for one bot count step of a load test */
+struct FECRBotLoadTestStepResult
+{
+	int32 BotCount = 0;
+	int32 NumFrames = 0;
+	double AverageFrameMs = 0.0;
+	double MaxFrameMs = 0.0;
+	double AverageReplicationMs = 0.0;
+	double MaxReplicationMs = 0.0;
+	uint64 UsedPhysicalMB = 0;
+	uint64 PeakUsedPhysicalMB = 0;
+};
+
+/**
+ * UECRBotLoadTestSubsystem
+ *
+ *	Scenario runner for headless server load tests. Adds bots running load-test behavior in steps and
+ *	records server frame time, replication time and memory for every bot count, then writes a CSV to the
+ *	profiling directory. Driven by the ECR.LoadTest.* console commands, e.g. on a dedicated server:
+ *	-nullrhi -ExecCmds="ECR.LoadTest.Start 64 8 30"
+ */
+UCLASS(Config=Game)
+class UECRBotLoadTestSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UECRBotLoadTestSubsystem();
+
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Starts adding BotsPerStep bots every step until MaxBots is reached, sampling each step for StepDuration seconds */
+	void StartLoadTest(int32 MaxBots, int32 BotsPerStep, float StepDuration);
+
+	/** Stops the running test, writes whatever was measured so far and removes the bots */
+	void StopLoadTest();
+
+	bool IsRunning() const { return bRunning; }
+
+protected:
+	/** Controller class spawned for load-test bots */
+	UPROPERTY(Config)
+	TSoftClassPtr<AECRPlayerBotController> BotControllerClass;
+
+	/** Seconds after adding bots before sampling starts, so spawning and initial replication don't skew the step */
+	UPROPERTY(Config)
+	float StepWarmupDuration = 5.f;
+
+private:
+	void HandleWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void HandlePostTickFlush(float DeltaSeconds);
+
+	void BeginStep();
+	void FinishStep();
+	void SpawnBots(int32 NumBots);
+	void DestroyBots();
+	void WriteResults() const;
+
+private:
+	UPROPERTY()
+	TArray<AECRPlayerBotController*> SpawnedBots;
+
+	TArray<FECRBotLoadTestStepResult> Results;
+	FECRBotLoadTestStepResult CurrentStep;
+
+	int32 TargetMaxBots = 0;
+	int32 TargetBotsPerStep = 0;
+	float TargetStepDuration = 0.f;
+
+	double StepStartTime = 0.0;
+	double FrameStartTime = 0.0;
+	double ReplicationStartTime = 0.0;
+	double LastMemorySampleTime = 0.0;
+	double TotalFrameMs = 0.0;
+	double TotalReplicationMs = 0.0;
+
+	bool bRunning = false;
+	bool bSampling = false;
+
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle PostTickFlushHandle;
+};
@@ -6,12 +6,28 @@
 #include "AbilitySystemGlobals.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/PlayerState.h"
+#include "EngineUtils.h"
+#include "ChaosVehicleMovementComponent.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Gameplay/GAS/ECRAbilitySystemComponent.h"
+#include "Gameplay/GAS/Components/ECRHealthComponent.h"
+#include "Gameplay/Equipment/ECRQuickBarComponent.h"
+#include "Gameplay/Vehicles/ECRWheeledVehiclePawn.h"
+#include "NativeGameplayTags.h"
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_InputTag_Weapon_Fire, "InputTag.Weapon.Fire");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_InputTag_Ability_Interact, "InputTag.Ability.Interact");
 
 AECRPlayerBotController::AECRPlayerBotController(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	bWantsPlayerState = true;
 	bStopAILogicOnUnposses = false;
+
+	PrimaryActorTick.bCanEverTick = true;
+
+	LoadTestFireInputTag = TAG_InputTag_Weapon_Fire;
+	LoadTestInteractInputTag = TAG_InputTag_Ability_Interact;
 }
 
 void AECRPlayerBotController::OnPlayerStateChanged()
@@ -78,6 +94,8 @@ void AECRPlayerBotController::ServerRestartController()
 
 void AECRPlayerBotController::OnUnPossess()
 {
+	SetLoadTestFireHeld(false);
+
 	// Make sure the pawn that is being unpossessed doesn't remain our ASC's avatar actor
 	if (APawn* PawnBeingUnpossessed = GetPawn())
 	{
@@ -92,3 +110,309 @@ void AECRPlayerBotController::OnUnPossess()
 
 	Super::OnUnPossess();
 }
+
+void AECRPlayerBotController::SetLoadTestBehaviorEnabled(bool bEnabled)
+{
+	if (GetNetMode() == NM_Client || bLoadTestBehaviorEnabled == bEnabled)
+	{
+		return;
+	}
+
+	bLoadTestBehaviorEnabled = bEnabled;
+	LoadTestTimeUntilThink = FMath::FRandRange(0.f, LoadTestThinkInterval);
+
+	if (!bEnabled)
+	{
+		SetLoadTestFireHeld(false);
+		StopMovement();
+		ClearFocus(EAIFocusPriority::Gameplay);
+		LoadTestVehicleGoal.Reset();
+	}
+}
+
+void AECRPlayerBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!bLoadTestBehaviorEnabled)
+	{
+		return;
+	}
+
+	// Player controllers feed ability input from PlayerTick, bots have to do it themselves
+	if (UECRAbilitySystemComponent* ECRASC = GetECRAbilitySystemComponent())
+	{
+		ECRASC->ProcessAbilityInput(DeltaSeconds, false);
+	}
+
+	if (APawn* MyPawn = GetPawn())
+	{
+		if (!LoadTestFallbackMoveDirection.IsZero())
+		{
+			MyPawn->AddMovementInput(LoadTestFallbackMoveDirection);
+		}
+	}
+
+	LoadTestTimeUntilThink -= DeltaSeconds;
+	if (LoadTestTimeUntilThink <= 0.f)
+	{
+		LoadTestTimeUntilThink = LoadTestThinkInterval * FMath::FRandRange(0.5f, 1.5f);
+		LoadTestThink();
+	}
+}
+
+void AECRPlayerBotController::LoadTestThink()
+{
+	APawn* MyPawn = GetPawn();
+	if (MyPawn == nullptr)
+	{
+		SetLoadTestFireHeld(false);
+		if (IsInState(NAME_Inactive))
+		{
+			ServerRestartController();
+		}
+		return;
+	}
+
+	const UECRHealthComponent* HealthComponent = UECRHealthComponent::FindHealthComponent(MyPawn);
+	if (HealthComponent && HealthComponent->IsDeadOrDying())
+	{
+		SetLoadTestFireHeld(false);
+		return;
+	}
+
+	if (MyPawn->IsA<AECRWheeledVehiclePawn>())
+	{
+		LoadTestThinkInVehicle(MyPawn);
+	}
+	else
+	{
+		LoadTestThinkOnFoot(MyPawn);
+	}
+}
+
+void AECRPlayerBotController::LoadTestThinkOnFoot(APawn* MyPawn)
+{
+	// Heading for a vehicle takes over everything else until we get in or lose it
+	if (APawn* Vehicle = LoadTestVehicleGoal.Get())
+	{
+		if (Vehicle->GetController() != nullptr)
+		{
+			LoadTestVehicleGoal.Reset();
+		}
+		else if (FVector::Dist(MyPawn->GetActorLocation(), Vehicle->GetActorLocation()) <= LoadTestVehicleEntryDistance)
+		{
+			PressLoadTestInput(LoadTestInteractInputTag);
+			LoadTestVehicleGoal.Reset();
+			return;
+		}
+		else
+		{
+			SetLoadTestFireHeld(false);
+			MoveToActor(Vehicle, LoadTestVehicleEntryDistance * 0.5f);
+			return;
+		}
+	}
+
+	if (FMath::FRand() < LoadTestVehicleChance)
+	{
+		if (APawn* Vehicle = FindLoadTestVehicle(MyPawn))
+		{
+			LoadTestVehicleGoal = Vehicle;
+			LoadTestFallbackMoveDirection = FVector::ZeroVector;
+			MoveToActor(Vehicle, LoadTestVehicleEntryDistance * 0.5f);
+			return;
+		}
+	}
+
+	if (APawn* Target = FindLoadTestTarget(MyPawn))
+	{
+		SetFocus(Target);
+		SetLoadTestFireHeld(!bLoadTestFireHeld || FMath::FRand() < 0.75f);
+	}
+	else
+	{
+		ClearFocus(EAIFocusPriority::Gameplay);
+		SetLoadTestFireHeld(false);
+	}
+
+	if (GetMoveStatus() == EPathFollowingStatus::Idle)
+	{
+		LoadTestWander(MyPawn);
+	}
+
+	if (FMath::FRand() < LoadTestEquipChance)
+	{
+		LoadTestCycleQuickBar();
+	}
+
+	if (FMath::FRand() < LoadTestInteractChance)
+	{
+		PressLoadTestInput(LoadTestInteractInputTag);
+	}
+}
+
+void AECRPlayerBotController::LoadTestThinkInVehicle(APawn* MyPawn)
+{
+	SetLoadTestFireHeld(false);
+	ClearFocus(EAIFocusPriority::Gameplay);
+
+	const AWheeledVehiclePawn* VehiclePawn = CastChecked<AWheeledVehiclePawn>(MyPawn);
+	UChaosVehicleMovementComponent* VehicleMovement = VehiclePawn->GetVehicleMovementComponent();
+	if (VehicleMovement == nullptr)
+	{
+		return;
+	}
+
+	const FVector VehicleLocation = MyPawn->GetActorLocation();
+	if (LoadTestDriveDestination.IsZero() || FVector::Dist2D(VehicleLocation, LoadTestDriveDestination) < LoadTestVehicleEntryDistance)
+	{
+		LoadTestDriveDestination = VehicleLocation + FVector(FMath::RandPointInCircle(LoadTestWanderRadius * 2.f), 0.f);
+	}
+
+	// Steer towards the destination, there is no vehicle path following to lean on
+	const FVector ToDestination = (LoadTestDriveDestination - VehicleLocation).GetSafeNormal2D();
+	const float SteerDot = FVector::DotProduct(MyPawn->GetActorRightVector(), ToDestination);
+	VehicleMovement->SetSteeringInput(FMath::Clamp(SteerDot * 2.f, -1.f, 1.f));
+	VehicleMovement->SetThrottleInput(1.f);
+	VehicleMovement->SetBrakeInput(0.f);
+
+	if (FMath::FRand() < LoadTestVehicleChance)
+	{
+		VehicleMovement->SetThrottleInput(0.f);
+		LoadTestDriveDestination = FVector::ZeroVector;
+		PressLoadTestInput(LoadTestInteractInputTag);
+	}
+}
+
+void AECRPlayerBotController::LoadTestWander(APawn* MyPawn)
+{
+	const FVector Destination = MyPawn->GetActorLocation() + FVector(FMath::RandPointInCircle(LoadTestWanderRadius), 0.f);
+
+	if (MoveToLocation(Destination) == EPathFollowingRequestResult::Failed)
+	{
+		// No navmesh on the map, just push the pawn around
+		LoadTestFallbackMoveDirection = (Destination - MyPawn->GetActorLocation()).GetSafeNormal2D();
+	}
+	else
+	{
+		LoadTestFallbackMoveDirection = FVector::ZeroVector;
+	}
+}
+
+void AECRPlayerBotController::LoadTestCycleQuickBar()
+{
+	UECRQuickBarComponent* QuickBar = FindComponentByClass<UECRQuickBarComponent>();
+	if (QuickBar == nullptr)
+	{
+		return;
+	}
+
+	const TArray<FName> Channels = QuickBar->GetChannels();
+	if (Channels.Num() > 0)
+	{
+		// Firing through a weapon swap would just fail activation
+		SetLoadTestFireHeld(false);
+		QuickBar->CycleActiveSlotForward(Channels[FMath::RandHelper(Channels.Num())]);
+	}
+}
+
+void AECRPlayerBotController::SetLoadTestFireHeld(bool bHeld)
+{
+	if (bLoadTestFireHeld == bHeld)
+	{
+		return;
+	}
+
+	bLoadTestFireHeld = bHeld;
+
+	if (UECRAbilitySystemComponent* ECRASC = GetECRAbilitySystemComponent())
+	{
+		if (bHeld)
+		{
+			ECRASC->AbilityInputTagPressed(LoadTestFireInputTag);
+		}
+		else
+		{
+			ECRASC->AbilityInputTagReleased(LoadTestFireInputTag);
+		}
+	}
+}
+
+void AECRPlayerBotController::PressLoadTestInput(const FGameplayTag& InputTag)
+{
+	if (UECRAbilitySystemComponent* ECRASC = GetECRAbilitySystemComponent())
+	{
+		// Released right away, the next ProcessAbilityInput will see both and run the press
+		ECRASC->AbilityInputTagPressed(InputTag);
+		ECRASC->AbilityInputTagReleased(InputTag);
+	}
+}
+
+APawn* AECRPlayerBotController::FindLoadTestTarget(const APawn* MyPawn) const
+{
+	const FVector MyLocation = MyPawn->GetActorLocation();
+	float BestDistSq = FMath::Square(LoadTestTargetRange);
+	APawn* BestTarget = nullptr;
+
+	// Only pawns owned by players or bots are worth shooting at
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AController* OtherController = It->Get();
+		APawn* OtherPawn = OtherController ? OtherController->GetPawn() : nullptr;
+		if (OtherController == this || OtherPawn == nullptr)
+		{
+			continue;
+		}
+
+		const UECRHealthComponent* HealthComponent = UECRHealthComponent::FindHealthComponent(OtherPawn);
+		if (HealthComponent && HealthComponent->IsDeadOrDying())
+		{
+			continue;
+		}
+
+		const float DistSq = FVector::DistSquared(MyLocation, OtherPawn->GetActorLocation());
+		if (DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			BestTarget = OtherPawn;
+		}
+	}
+
+	if (BestTarget && !LineOfSightTo(BestTarget))
+	{
+		return nullptr;
+	}
+
+	return BestTarget;
+}
+
+APawn* AECRPlayerBotController::FindLoadTestVehicle(const APawn* MyPawn) const
+{
+	const FVector MyLocation = MyPawn->GetActorLocation();
+	float BestDistSq = FMath::Square(LoadTestVehicleSearchRange);
+	APawn* BestVehicle = nullptr;
+
+	for (TActorIterator<AECRWheeledVehiclePawn> It(GetWorld()); It; ++It)
+	{
+		AECRWheeledVehiclePawn* Vehicle = *It;
+		if (Vehicle->GetController() != nullptr)
+		{
+			continue;
+		}
+
+		const float DistSq = FVector::DistSquared(MyLocation, Vehicle->GetActorLocation());
+		if (DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			BestVehicle = Vehicle;
+		}
+	}
+
+	return BestVehicle;
+}
+
+UECRAbilitySystemComponent* AECRPlayerBotController::GetECRAbilitySystemComponent() const
+{
+	return Cast<UECRAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PlayerState));
+}
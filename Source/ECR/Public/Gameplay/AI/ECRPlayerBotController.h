@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "ModularAIController.h"
+#include "GameplayTagContainer.h"
 #include "ECRPlayerBotController.generated.h"
 
+class UECRAbilitySystemComponent;
+
 /**
  * AECRPlayerBotController
  *
@@ -24,6 +27,16 @@ public:
 
 	virtual void OnUnPossess() override;
 
+	// Enables scripted load-test behavior (move, aim, fire, interact, equip and enter vehicles). Server only.
+	void SetLoadTestBehaviorEnabled(bool bEnabled);
+
+	bool IsLoadTestBehaviorEnabled() const { return bLoadTestBehaviorEnabled; }
+
+	// Are the input tags load-test bots fire and interact with set?
+	bool HasValidLoadTestInputTags() const { return LoadTestFireInputTag.IsValid() && LoadTestInteractInputTag.IsValid(); }
+
+	virtual void Tick(float DeltaSeconds) override;
+
 protected:
 	// Called when the player state is set or cleared
 	virtual void OnPlayerStateChanged();
@@ -38,7 +51,66 @@ protected:
 	virtual void OnRep_PlayerState() override;
 	//~End of AController interface
 
+	/** Input tag pressed to fire the equipped weapon during load tests */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest", meta=(Categories="InputTag"))
+	FGameplayTag LoadTestFireInputTag;
+
+	/** Input tag pressed to interact (and enter or leave vehicles) during load tests */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest", meta=(Categories="InputTag"))
+	FGameplayTag LoadTestInteractInputTag;
+
+	/** Seconds between load-test decisions, randomized by +-50% so bots don't think in lockstep */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest")
+	float LoadTestThinkInterval = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest")
+	float LoadTestWanderRadius = 2500.f;
+
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest")
+	float LoadTestTargetRange = 5000.f;
+
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest")
+	float LoadTestVehicleSearchRange = 3000.f;
+
+	/** Distance to a vehicle at which the bot presses interact to get in */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest")
+	float LoadTestVehicleEntryDistance = 300.f;
+
+	/** Chances per think to cycle the quick bar, interact and head for a vehicle */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest", meta=(ClampMin=0, ClampMax=1))
+	float LoadTestEquipChance = 0.05f;
+
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest", meta=(ClampMin=0, ClampMax=1))
+	float LoadTestInteractChance = 0.05f;
+
+	UPROPERTY(EditDefaultsOnly, Category="ECR|LoadTest", meta=(ClampMin=0, ClampMax=1))
+	float LoadTestVehicleChance = 0.02f;
+
+private:
+	void LoadTestThink();
+	void LoadTestThinkOnFoot(APawn* MyPawn);
+	void LoadTestThinkInVehicle(APawn* MyPawn);
+	void LoadTestWander(APawn* MyPawn);
+	void LoadTestCycleQuickBar();
+	void SetLoadTestFireHeld(bool bHeld);
+	void PressLoadTestInput(const FGameplayTag& InputTag);
+
+	APawn* FindLoadTestTarget(const APawn* MyPawn) const;
+	APawn* FindLoadTestVehicle(const APawn* MyPawn) const;
+
+	UECRAbilitySystemComponent* GetECRAbilitySystemComponent() const;
+
 private:
 	UPROPERTY()
 	APlayerState* LastSeenPlayerState;
+
+	bool bLoadTestBehaviorEnabled = false;
+	bool bLoadTestFireHeld = false;
+	float LoadTestTimeUntilThink = 0.f;
+
+	// Used when there is no navigation data to path on
+	FVector LoadTestFallbackMoveDirection = FVector::ZeroVector;
+	FVector LoadTestDriveDestination = FVector::ZeroVector;
+
+	TWeakObjectPtr<APawn> LoadTestVehicleGoal;
 };
@@ -30,6 +30,14 @@ protected:
 	void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc,
 	                              float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
 
+	/** Sweeps a single feeler and returns its blocked percentage (1 if nothing relevant was hit) */
+	float TraceFeeler(FECRPenetrationAvoidanceFeeler& Feeler, class AActor const& ViewTarget, FVector const& SafeLoc,
+	                  FVector const& BaseRay, FVector const& BaseRayLocalUp, FVector const& BaseRayLocalRight,
+	                  FCollisionQueryParams& SphereParams);
+
+	/** Whether pivot and camera stayed close enough to the last traced positions to reuse cached feeler results */
+	bool CanReuseCachedFeelers(FVector const& SafeLoc, FVector const& CameraLoc) const;
+
 	virtual void DrawDebug(UCanvas* Canvas) const override;
 
 	// Penetration prevention
@@ -65,6 +73,18 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Collision")
 	TArray<FECRPenetrationAvoidanceFeeler> PenetrationAvoidanceFeelers;
 
+	/**
+	 * Maximum number of predictive feelers (index 1+) traced in a single frame. The main feeler is always traced.
+	 * Feelers that are due but over budget are picked up on the following frames in round-robin order.
+	 * 0 or less means no limit.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Collision")
+	int32 MaxPredictiveFeelerTracesPerFrame = 2;
+
+	/** While pivot and camera move less than this distance, predictive feelers reuse their cached results */
+	UPROPERTY(EditDefaultsOnly, Category = "Collision", meta=(ClampMin="0.0"))
+	float FeelerCacheReuseDistance = 2.f;
+
 
 	UPROPERTY(Transient)
 	float AimLineToDesiredPosBlockedPct;
@@ -72,6 +92,15 @@ public:
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<const AActor>> DebugActorsHitDuringCameraPenetration;
 
+private:
+	// Predictive feeler to start from on the next budgeted frame
+	int32 NextPredictiveFeelerIndex = 1;
+
+	// Pivot and camera locations from the last time predictive feelers were traced
+	FVector LastFeelerSafeLoc = FVector::ZeroVector;
+	FVector LastFeelerCameraLoc = FVector::ZeroVector;
+	bool bHasCachedFeelerResults = false;
+
 #if ENABLE_DRAW_DEBUG
 	mutable float LastDrawDebugTime = -MAX_FLT;
 #endif
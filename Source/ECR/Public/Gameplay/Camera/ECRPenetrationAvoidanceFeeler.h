@@ -38,6 +38,10 @@ struct FECRPenetrationAvoidanceFeeler
 	UPROPERTY(transient)
 	int32 FramesUntilNextTrace;
 
+	/** blocked percentage found by the last trace of this feeler, reused on frames it is not traced */
+	UPROPERTY(transient)
+	float CachedBlockedPct;
+
 
 	FECRPenetrationAvoidanceFeeler()
 		: AdjustmentRot(ForceInit)
@@ -46,6 +50,7 @@ struct FECRPenetrationAvoidanceFeeler
 		, Extent(0)
 		, TraceInterval(0)
 		, FramesUntilNextTrace(0)
+		, CachedBlockedPct(1.f)
 	{
 	}
 
@@ -61,6 +66,7 @@ struct FECRPenetrationAvoidanceFeeler
 		, Extent(InExtent)
 		, TraceInterval(InTraceInterval)
 		, FramesUntilNextTrace(InFramesUntilNextTrace)
+		, CachedBlockedPct(1.f)
 	{
 	}
 };
\ No newline at end of file
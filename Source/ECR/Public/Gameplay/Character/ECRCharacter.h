@@ -88,12 +88,15 @@ public:
 	void ToggleCrouch();
 
 	//~AActor interface
+	virtual void PreRegisterAllComponents() override;
 	virtual void PreInitializeComponents() override;
 	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Reset() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual bool IsReplayRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation,
+	                                 const float CullDistance) const override;
 	//~End of AActor interface
 
 	// Interactions
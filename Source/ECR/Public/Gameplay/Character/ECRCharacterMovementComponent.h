@@ -9,6 +9,8 @@
 
 ECR_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_MovementStopped);
 
+class UAbilitySystemComponent;
+
 
 /**
  * FECRCharacterGroundInfo
@@ -51,7 +53,13 @@ public:
 
 	virtual bool CanAttemptJump() const override;
 
-	// Returns the current ground info.  Calling this will update the ground info if it's out of date.
+	// Binds the cached movement modifiers to gameplay tag events of the ability system
+	void InitializeWithAbilitySystem(UAbilitySystemComponent* InASC);
+
+	// Unbinds from the ability system and clears the cached movement modifiers
+	void UninitializeFromAbilitySystem();
+
+	// Returns the current ground info.  Calling this will update the ground info if the character moved since.
 	UFUNCTION(BlueprintCallable, Category = "ECR|CharacterMovement")
 	const FECRCharacterGroundInfo& GetGroundInfo();
 
@@ -68,10 +76,26 @@ protected:
 
 	virtual void InitializeComponent() override;
 
+	//~UCharacterMovementComponent interface
+	virtual void ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData) override;
+	//~End of UCharacterMovementComponent interface
+
+	void HandleMovementStoppedTagChanged(const FGameplayTag Tag, int32 NewCount);
+
 protected:
 	// Cached ground info for the character.  Do not access this directly!  It's only updated when accessed via GetGroundInfo().
 	FECRCharacterGroundInfo CachedGroundInfo;
 
+	// Movement mode the cached ground info was traced in, MOVE_None if it has to be traced again
+	TEnumAsByte<EMovementMode> GroundInfoMovementMode = MOVE_None;
+
+	// Whether TAG_Gameplay_MovementStopped is present on the ability system. Kept up to date by tag events so
+	// GetMaxSpeed and GetDeltaRotation don't have to query tags on every movement substep.
+	bool bMovementStopped = false;
+
+	TWeakObjectPtr<UAbilitySystemComponent> MovementModifiersAbilitySystem;
+	FDelegateHandle MovementStoppedTagChangedHandle;
+
 private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess = "true"))
 	bool bDontApplyImpactOnVehicles;
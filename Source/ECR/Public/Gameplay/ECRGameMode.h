@@ -6,6 +6,18 @@
 #include "GameFramework/GameMode.h"
 #include "ECRGameMode.generated.h"
 
+/** How much an actor matters to a server replay, used to filter what gets recorded */
+UENUM()
+enum class EECRReplayImportance : uint8
+{
+	// Never recorded, only actors of the explicitly excluded classes
+	Excluded,
+	// Recorded, at a reduced rate while no player has it relevant
+	Gameplay,
+	// Match state, players and their pawns, always recorded at the full rate
+	Critical
+};
+
 UCLASS(minimalapi)
 // ReSharper disable once CppUE4CodingStandardNamingViolationWarning
 class AECRGameMode : public AGameMode
@@ -23,9 +35,42 @@ protected:
 	virtual FString InitNewPlayer(APlayerController* NewPlayerController, const FUniqueNetIdRepl& UniqueId,
 	                              const FString& Options, const FString& Portal) override;
 
+	virtual void PostLogin(APlayerController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Classifies an actor for server replay recording. Actors that don't replicate are never recorded anyway. */
+	virtual EECRReplayImportance GetReplayImportance(const AActor* Actor) const;
+
+	/** Whether server replays record actors by gameplay importance instead of everything that replicates at the full rate */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|Replays")
+	bool bFilterReplayRecording = false;
+
+	/** Actors of these classes are never recorded into server replays */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|Replays", meta=(EditCondition="bFilterReplayRecording"))
+	TArray<TSubclassOf<AActor>> ReplayExcludedActorClasses;
+
+	/** Recording rate for gameplay actors that are not relevant to any player */
+	UPROPERTY(EditDefaultsOnly, Category="ECR|Replays", meta=(EditCondition="bFilterReplayRecording"))
+	float ReplayRecordHzWhenNotRelevant = 1.f;
+
+private:
+	/** Update player amount in the advertised session, pushed to the online service in batches */
+	void UpdateAdvertisedPlayerAmount();
+
+	void StartReplayRecordingFilter();
+	void ApplyReplayImportance(AActor* Actor) const;
+	void HandleActorSpawnedForReplay(AActor* Actor);
+
+	FDelegateHandle ActorSpawnedForReplayHandle;
+
 public:
 	AECRGameMode();
 
+	/** Whether the actor is recorded at the full rate into server replays even when no player has it relevant */
+	static bool IsCriticalForReplay(const AActor* Actor);
+
 	// Agnostic version of PlayerCanRestart that can be used for both player bots and players
 	virtual bool ControllerCanRestart(AController* Controller);
 };
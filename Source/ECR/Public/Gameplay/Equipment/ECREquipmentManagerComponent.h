@@ -75,9 +75,18 @@ public:
 	UECREquipmentInstance* AddEntry(TSubclassOf<UECREquipmentDefinition> EquipmentDefinition);
 	void RemoveEntry(UECREquipmentInstance* Instance);
 
+	/** Returns the equipped instances that are of the given type or derive from it, in equip order */
+	const TArray<UECREquipmentInstance*>* FindInstancesOfType(const UClass* InstanceType) const;
+
 private:
 	UECRAbilitySystemComponent* GetAbilitySystemComponent() const;
 
+	void AddToTypeIndex(UECREquipmentInstance* Instance);
+	void RemoveFromTypeIndex(UECREquipmentInstance* Instance);
+
+	// Rebuilds the index from entries, for removals and changes whose previous instance is no longer known
+	void RebuildTypeIndex(const TArrayView<int32> ExcludedIndices);
+
 	friend UECREquipmentManagerComponent;
 
 private:
@@ -87,6 +96,10 @@ private:
 
 	UPROPERTY()
 	UActorComponent* OwnerComponent;
+
+	// Instances keyed by their class and every parent class up to UECREquipmentInstance, kept up to date on both
+	// authority (AddEntry/RemoveEntry) and clients (replication callbacks). Entries holds the strong references.
+	TMap<const UClass*, TArray<UECREquipmentInstance*>> InstancesByType;
 };
 
 template <>
@@ -132,14 +145,14 @@ public:
 
 	/** Returns the first equipped instance of a given type, or nullptr if none are found */
 	UFUNCTION(BlueprintCallable, BlueprintPure)
-	UECREquipmentInstance* GetFirstInstanceOfType(TSubclassOf<UECREquipmentInstance> InstanceType);
+	UECREquipmentInstance* GetFirstInstanceOfType(TSubclassOf<UECREquipmentInstance> InstanceType) const;
 
 	/** Returns all equipped instances of a given type, or an empty array if none are found */
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	TArray<UECREquipmentInstance*> GetEquipmentInstancesOfType(TSubclassOf<UECREquipmentInstance> InstanceType) const;
 
 	template <typename T>
-	T* GetFirstInstanceOfType()
+	T* GetFirstInstanceOfType() const
 	{
 		return (T*)GetFirstInstanceOfType(T::StaticClass());
 	}
@@ -133,6 +133,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ECR|Ability")
 	void ToggleMovementEnabled(bool bNewEnabled);
 
+	/**
+	 * Applies an instant effect spec to every hit of the target data in one pass, for explosions and shotgun blasts.
+	 * One spec and effect context are shared by all hits, hits on the same target are applied in a row and their
+	 * damage messages are merged. Non-instant effects are applied per target as usual. Returns amount of hits applied
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "ECR|Ability")
+	int32 ApplyGameplayEffectSpecToHits(const FGameplayEffectSpecHandle& SpecHandle,
+	                                    const FGameplayAbilityTargetDataHandle& TargetData);
+
 	void OnAbilityFailedToActivate(const FGameplayTagContainer& FailedReason) const
 	{
 		NativeOnAbilityFailedToActivate(FailedReason);
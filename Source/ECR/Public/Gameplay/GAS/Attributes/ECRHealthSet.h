@@ -6,6 +6,7 @@
 #include "AttributeSet.h"
 #include "ECRAttributeSet.h"
 #include "NativeGameplayTags.h"
+#include "UObject/ObjectKey.h"
 #include "ECRHealthSet.generated.h"
 
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_Damage);
@@ -14,6 +15,29 @@ UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_DamageSelfDestruct);
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_FellOutOfWorld);
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_ECR_Damage_Message);
 
+struct FECRVerbMessage;
+
+
+/**
+ * Batches damage messages of health sets in the world while in scope. Damage of one instigator to the same target is
+ * merged into a single message with the summed magnitude, broadcast when the outermost scope of the world ends or
+ * earlier when the target becomes wounded or ready to die. Game thread only.
+ */
+struct ECR_API FECRScopedDamageMessageBatch
+{
+	explicit FECRScopedDamageMessageBatch(UWorld* InWorld);
+	~FECRScopedDamageMessageBatch();
+
+	/** Add message to the open batch, returns false if there is none and the message should be broadcast directly */
+	static bool AddMessage(const FECRVerbMessage& Message, UWorld* World);
+
+	/** Broadcast pending messages to the target now, so they arrive before its wounded or death events */
+	static void FlushMessagesTo(const AActor* Target);
+
+private:
+	TObjectKey<UWorld> World;
+};
+
 
 /**
  * Basic class for taking damage.
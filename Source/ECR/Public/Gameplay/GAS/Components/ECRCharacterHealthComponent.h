@@ -9,6 +9,35 @@
 
 class UECRMovementSet;
 class UECRCharacterHealthSet;
+class UECRCharacterHealthComponent;
+
+
+/**
+ * FECRAttributeChange
+ *
+ *	Change of one attribute during a frame, from its value before the first change to the latest value.
+ */
+USTRUCT(BlueprintType)
+struct FECRAttributeChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "ECR|Health")
+	FGameplayAttribute Attribute;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ECR|Health")
+	float OldValue = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ECR|Health")
+	float NewValue = 0.0f;
+
+	// Instigator of the latest change that had one
+	UPROPERTY(BlueprintReadOnly, Category = "ECR|Health")
+	AActor* Instigator = nullptr;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FECRHealth_AttributesChanged, UECRCharacterHealthComponent*,
+                                             HealthComponent, const TArray<FECRAttributeChange>&, Changes);
 
 /**
  * UECRCharacterHealthComponent
@@ -83,7 +112,11 @@ public:
 	float GetEvasionStaminaNormalized() const;
 
 public:
-	// Delegate fired when the shield value has changed.
+	// Delegate fired once per frame with all shield, bleeding health and stamina changes of the frame.
+	UPROPERTY(BlueprintAssignable)
+	FECRHealth_AttributesChanged OnAttributesChanged;
+
+	// Delegate fired when the shield value has changed. Like the ones below, at most once per frame.
 	UPROPERTY(BlueprintAssignable)
 	FECRHealth_AttributeChanged OnShieldChanged;
 
@@ -124,11 +157,17 @@ protected:
 	virtual void HandleRootMotionScaleChanged(const FOnAttributeChangeData& ChangeData);
 	virtual void HandleWalkSpeedChanged(const FOnAttributeChangeData& ChangeData);
 
-	virtual void HandleShieldChanged(const FOnAttributeChangeData& ChangeData);
-	virtual void HandleMaxShieldChanged(const FOnAttributeChangeData& ChangeData);
+	// Calls Func for every attribute collected into OnAttributesChanged
+	void ForEachObservedAttribute(TFunctionRef<void(const FGameplayAttribute& Attribute)> Func) const;
+
+	// Collects change of an observed attribute, listeners are notified on the next tick
+	void HandleObservedAttributeChanged(const FOnAttributeChangeData& ChangeData);
+
+	// Broadcasts changes collected since the last flush
+	void FlushAttributeChanges();
 
-	virtual void HandleBleedingHealthChanged(const FOnAttributeChangeData& ChangeData);
-	virtual void HandleMaxBleedingHealthChanged(const FOnAttributeChangeData& ChangeData);
+	// Broadcasts the delegate of the single attribute
+	virtual void BroadcastAttributeChange(const FECRAttributeChange& Change);
 
 	virtual void HandleReadyToBecomeWounded(AActor* DamageInstigator, AActor* DamageCauser,
 	                                        const FGameplayEffectSpec& DamageEffectSpec, float DamageMagnitude);
@@ -136,12 +175,6 @@ protected:
 	virtual void HandleReadyToBecomeUnwounded(AActor* EffectInstigator, AActor* EffectCauser,
 	                                          const FGameplayEffectSpec& EffectSpec, float EffectMagnitude);
 
-	virtual void HandleStaminaChanged(const FOnAttributeChangeData& ChangeData);
-	virtual void HandleMaxStaminaChanged(const FOnAttributeChangeData& ChangeData);
-
-	virtual void HandleEvasionStaminaChanged(const FOnAttributeChangeData& ChangeData);
-	virtual void HandleMaxEvasionStaminaChanged(const FOnAttributeChangeData& ChangeData);
-
 	virtual float GetDamageToKill() override;
 
 protected:
@@ -152,4 +185,15 @@ protected:
 	// Movement set used by this component.
 	UPROPERTY()
 	const UECRMovementSet* CharacterMovementSet;
+
+private:
+	// Observed attribute changes since the last flush, one per attribute
+	UPROPERTY(Transient)
+	TArray<FECRAttributeChange> PendingAttributeChanges;
+
+	// Changes being broadcast, kept to reuse the allocation
+	UPROPERTY(Transient)
+	TArray<FECRAttributeChange> FlushedAttributeChanges;
+
+	FTimerHandle AttributeChangeFlushHandle;
 };
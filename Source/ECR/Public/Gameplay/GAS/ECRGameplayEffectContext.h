@@ -56,6 +56,12 @@ struct FECRGameplayEffectContext : public FGameplayEffectContext
 	/** Returns the physical material from the hit result if there is one */
 	const UPhysicalMaterial* GetPhysicalMaterial() const;
 
+	/**
+	 * Replaces the hit result and moves the origin to its trace start. Unlike AddHitResult the hit result allocation
+	 * is reused when this context is its only owner. Null clears the hit result and keeps the origin
+	 */
+	void ReplaceHitResult(const FHitResult* InHitResult);
+
 public:
 	/** ID to allow the identification of multiple bullets that were part of the same cartridge */
 	UPROPERTY()
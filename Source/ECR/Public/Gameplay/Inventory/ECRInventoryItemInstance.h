@@ -59,6 +59,9 @@ public:
 private:
 	void SetItemDef(TSubclassOf<UECRInventoryItemDefinition> InDef);
 
+	UFUNCTION()
+	void OnRep_ItemDef();
+
 	friend struct FECRInventoryList;
 
 private:
@@ -66,7 +69,7 @@ private:
 	FGameplayTagStackContainer StatTags;
 
 	// The item definition
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing=OnRep_ItemDef)
 	TSubclassOf<UECRInventoryItemDefinition> ItemDef;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
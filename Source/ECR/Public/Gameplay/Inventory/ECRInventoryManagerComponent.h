@@ -93,9 +93,21 @@ public:
 
 	void RemoveEntry(UECRInventoryItemInstance* Instance);
 
+	/** Returns the item instances created from the given definition, in the order they were added */
+	const TArray<UECRInventoryItemInstance*>* FindInstancesByDefinition(TSubclassOf<UECRInventoryItemDefinition> ItemDef) const;
+
+	/** Indexes the instance if it belongs to this list, for definitions replicated after the entry */
+	void HandleItemDefReplicated(UECRInventoryItemInstance* Instance);
+
 private:
 	void BroadcastChangeMessage(FECRInventoryEntry& Entry, int32 OldCount, int32 NewCount);
 
+	void AddToDefinitionIndex(UECRInventoryItemInstance* Instance);
+	void RemoveFromDefinitionIndex(UECRInventoryItemInstance* Instance);
+
+	// Rebuilds the index from entries, for removals whose instance is no longer known
+	void RebuildDefinitionIndex(const TArrayView<int32> ExcludedIndices);
+
 private:
 	friend UECRInventoryManagerComponent;
 
@@ -106,6 +118,10 @@ private:
 
 	UPROPERTY()
 	UActorComponent* OwnerComponent;
+
+	// Instances keyed by their item definition, kept up to date on both authority (AddEntry/RemoveEntry)
+	// and clients (replication callbacks). Entries holds the strong references.
+	TMap<TSubclassOf<UECRInventoryItemDefinition>, TArray<UECRInventoryItemInstance*>> InstancesByDefinition;
 };
 
 template<>
@@ -147,6 +163,9 @@ public:
 	int32 GetTotalItemCountByDefinition(TSubclassOf<UECRInventoryItemDefinition> ItemDef) const;
 	bool ConsumeItemsByDefinition(TSubclassOf<UECRInventoryItemDefinition> ItemDef, int32 NumToConsume);
 
+	// Called by item instances when their definition replicates
+	void HandleItemDefReplicated(UECRInventoryItemInstance* Instance) { InventoryList.HandleItemDefReplicated(Instance); }
+
 	//~UObject interface
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 	//~End of UObject interface
@@ -5,12 +5,15 @@
 #include "CoreMinimal.h"
 #include "ModularPlayerState.h"
 #include "AbilitySystemInterface.h"
+#include "Customization/CustomizationLoadoutInterface.h"
 #include "System/GameplayTagStack.h"
 
 #include "ECRPlayerState.generated.h"
 
 class UECRAbilitySystemComponent;
 class UAbilitySystemComponent;
+class UCustomizationElementaryAsset;
+class UCustomizationMaterialAsset;
 
 
 /**
@@ -19,7 +22,7 @@ class UAbilitySystemComponent;
  *	Base player state class used by this project.
  */
 UCLASS(Config = Game)
-class ECR_API AECRPlayerState : public AModularPlayerState
+class ECR_API AECRPlayerState : public AModularPlayerState, public ICustomizationLoadoutInterface
 {
 	GENERATED_BODY()
 
@@ -53,4 +56,25 @@ public:
 
 	UPROPERTY(Replicated)
 	FGameplayTagStackContainer StatTags;
+
+	// Sets the customization the pawn of this player will be loaded with, so clients can stream it in before it spawns
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Customization)
+	void SetCustomizationLoadout(const TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+	                             const TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs);
+
+	//~ICustomizationLoadoutInterface interface
+	virtual void GetCustomizationLoadout_Implementation(
+		TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+		TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs) const override;
+	//~End of ICustomizationLoadoutInterface interface
+
+private:
+	UFUNCTION()
+	void OnRep_CustomizationLoadout();
+
+	UPROPERTY(ReplicatedUsing=OnRep_CustomizationLoadout)
+	TArray<TSoftObjectPtr<UCustomizationElementaryAsset>> CustomizationElementaryAssets;
+
+	UPROPERTY(ReplicatedUsing=OnRep_CustomizationLoadout)
+	TArray<TSoftObjectPtr<UCustomizationMaterialAsset>> CustomizationMaterialConfigs;
 };
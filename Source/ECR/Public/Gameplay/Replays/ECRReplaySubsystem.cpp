@@ -4,16 +4,40 @@
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 #include "Engine/DemoNetDriver.h"
+#include "HAL/IConsoleManager.h"
+
+namespace ECRReplaySubsystem_Statics
+{
+	static constexpr float CheckpointIntervalUpdatePeriod = 5.f;
+
+	static void SetDemoConsoleVariable(const TCHAR* Name, float Value)
+	{
+		if (IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			ConsoleVariable->Set(Value, ECVF_SetByCode);
+		}
+	}
+}
 
 UECRReplaySubsystem::UECRReplaySubsystem()
 {
 }
 
+void UECRReplaySubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(CheckpointIntervalTickerHandle);
+	CheckpointIntervalTickerHandle.Reset();
+
+	Super::Deinitialize();
+}
+
 void UECRReplaySubsystem::PlayReplay(UECRReplayListEntry* Replay)
 {
 	if (Replay != nullptr)
 	{
 		FString DemoName = Replay->StreamInfo.Name;
+		bSeekInFlight = false;
+		PendingSeekTime = -1.f;
 		GetGameInstance()->PlayReplay(DemoName);
 	}
 }
@@ -22,12 +46,23 @@ void UECRReplaySubsystem::StartRecordingReplay(const FString Name, const FString
 {
 	if (UGameInstance* GameInstance = GetGameInstance())
 	{
+		ApplyRecordingSettings();
 		GameInstance->StartRecordingReplay(Name, FriendlyName);
+
+		if (!CheckpointIntervalTickerHandle.IsValid())
+		{
+			CheckpointIntervalTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateUObject(this, &ThisClass::UpdateCheckpointInterval),
+				ECRReplaySubsystem_Statics::CheckpointIntervalUpdatePeriod);
+		}
 	}
 }
 
 void UECRReplaySubsystem::StopRecordingReplay()
 {
+	FTSTicker::GetCoreTicker().RemoveTicker(CheckpointIntervalTickerHandle);
+	CheckpointIntervalTickerHandle.Reset();
+
 	if (UGameInstance* GameInstance = GetGameInstance())
 	{
 		GameInstance->StopRecordingReplay();
@@ -84,11 +119,79 @@ void UECRReplaySubsystem::ChangeReplayPlayingSpeed(const float NewSpeed)
 }
 
 void UECRReplaySubsystem::SeekInActiveReplay(float TimeInSeconds)
+{
+	ScrubToTime(TimeInSeconds);
+}
+
+void UECRReplaySubsystem::ScrubToTime(float TimeInSeconds)
+{
+	const UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if (DemoDriver == nullptr)
+	{
+		return;
+	}
+
+	const float TargetTime = FMath::Clamp(TimeInSeconds, 0.f, DemoDriver->GetDemoTotalTime());
+
+	if (bSeekInFlight)
+	{
+		// Only the latest request matters, it runs as soon as the current seek lands
+		PendingSeekTime = TargetTime;
+		return;
+	}
+
+	StartSeek(TargetTime);
+}
+
+void UECRReplaySubsystem::ScrubByDelta(float DeltaSeconds)
+{
+	float BaseTime = GetReplayCurrentTime();
+	if (PendingSeekTime >= 0.f)
+	{
+		BaseTime = PendingSeekTime;
+	}
+	else if (bSeekInFlight)
+	{
+		BaseTime = LastSeekTarget;
+	}
+
+	ScrubToTime(BaseTime + DeltaSeconds);
+}
+
+void UECRReplaySubsystem::StartSeek(float TimeInSeconds)
 {
 	if (UDemoNetDriver* DemoDriver = GetDemoDriver())
 	{
-		DemoDriver->GotoTimeInSeconds(TimeInSeconds);
+		bSeekInFlight = true;
+		LastSeekTarget = TimeInSeconds;
+
+		// The demo driver fast forwards from the current position when that is closer than the previous checkpoint
+		const bool bStarted = DemoDriver->GotoTimeInSeconds(TimeInSeconds, FOnGotoTimeDelegate::CreateUObject(
+			                                                    this, &ThisClass::HandleSeekCompleted, TimeInSeconds));
+
+		// A rejected seek never completes, unless the driver already reported it through the delegate
+		if (!bStarted && bSeekInFlight)
+		{
+			bSeekInFlight = false;
+			PendingSeekTime = -1.f;
+			OnScrubCompleted.Broadcast(false, TimeInSeconds);
+		}
+	}
+}
+
+void UECRReplaySubsystem::HandleSeekCompleted(bool bSucceeded, float TimeInSeconds)
+{
+	bSeekInFlight = false;
+
+	if (PendingSeekTime >= 0.f)
+	{
+		const float NextSeekTime = PendingSeekTime;
+		PendingSeekTime = -1.f;
+		StartSeek(NextSeekTime);
+		return;
 	}
+
+	OnScrubCompleted.Broadcast(bSucceeded, TimeInSeconds);
 }
 
 float UECRReplaySubsystem::GetReplayLengthInSeconds() const
@@ -117,3 +220,33 @@ UDemoNetDriver* UECRReplaySubsystem::GetDemoDriver() const
 	}
 	return nullptr;
 }
+
+void UECRReplaySubsystem::ApplyRecordingSettings()
+{
+	using namespace ECRReplaySubsystem_Statics;
+
+	// Checkpoints are spread over frames instead of stalling the one they start in
+	SetDemoConsoleVariable(TEXT("demo.CheckpointSaveMaxMSPerFrameOverride"), CheckpointSaveMaxMSPerFrame);
+	SetDemoConsoleVariable(TEXT("demo.RecordHz"), RecordHz);
+	SetDemoConsoleVariable(TEXT("demo.CheckpointUploadDelay"), CalculateCheckpointInterval(0));
+}
+
+bool UECRReplaySubsystem::UpdateCheckpointInterval(float DeltaTime)
+{
+	const UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if (DemoDriver && DemoDriver->IsRecording())
+	{
+		const int32 NumNetworkObjects = DemoDriver->GetNetworkObjectList().GetAllObjects().Num();
+		ECRReplaySubsystem_Statics::SetDemoConsoleVariable(
+			TEXT("demo.CheckpointUploadDelay"), CalculateCheckpointInterval(NumNetworkObjects));
+	}
+	return true;
+}
+
+float UECRReplaySubsystem::CalculateCheckpointInterval(int32 NumNetworkObjects) const
+{
+	// Checkpoint size grows with the number of objects, so bigger worlds checkpoint less often to keep the
+	// amortized recording cost flat, up to the interval that still gives acceptable seek times
+	const float SizeScale = FMath::Max(1.f, static_cast<float>(NumNetworkObjects) / FMath::Max(CheckpointReferenceObjectCount, 1));
+	return FMath::Clamp(MinCheckpointInterval * SizeScale, MinCheckpointInterval, FMath::Max(MinCheckpointInterval, MaxCheckpointInterval));
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "NetworkReplayStreaming.h"
+#include "Containers/Ticker.h"
 
 #include "ECRReplaySubsystem.generated.h"
 
@@ -51,7 +52,9 @@ public:
 	TArray<UECRReplayListEntry*> Results;
 };
 
-UCLASS()
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FECRReplayScrubCompleted, bool, bSucceeded, float, TimeInSeconds);
+
+UCLASS(Config=Game)
 class UECRReplaySubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -59,6 +62,10 @@ class UECRReplaySubsystem : public UGameInstanceSubsystem
 public:
 	UECRReplaySubsystem();
 
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
 	UFUNCTION(BlueprintCallable, Category=Replays)
 	void PlayReplay(UECRReplayListEntry* Replay);
 
@@ -80,6 +87,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Replays)
 	void SeekInActiveReplay(float TimeInSeconds);
 
+	/**
+	 * Jumps to any time in the active replay. Only one seek runs at a time; requests made while one is in flight
+	 * are coalesced into the latest, so dragging a scrub bar never queues up more than one extra seek.
+	 * Each seek loads the closest checkpoint before the target and fast forwards at most one checkpoint interval.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Replays)
+	void ScrubToTime(float TimeInSeconds);
+
+	/** Scrubs relative to the current (or pending) replay time */
+	UFUNCTION(BlueprintCallable, Category=Replays)
+	void ScrubByDelta(float DeltaSeconds);
+
+	UFUNCTION(BlueprintCallable, Category=Replays, BlueprintPure=false)
+	bool IsScrubbing() const { return bSeekInFlight; }
+
+	/** Broadcast when a scrub lands, after any coalesced requests were applied */
+	UPROPERTY(BlueprintAssignable, Category=Replays)
+	FECRReplayScrubCompleted OnScrubCompleted;
+
 	UFUNCTION(BlueprintCallable, Category = Replays, BlueprintPure = false)
 	float GetReplayLengthInSeconds() const;
 
@@ -88,4 +114,42 @@ public:
 
 private:
 	UDemoNetDriver* GetDemoDriver() const;
+
+	void StartSeek(float TimeInSeconds);
+	void HandleSeekCompleted(bool bSucceeded, float TimeInSeconds);
+
+	/** Pushes checkpoint and record rate settings to the demo driver before recording starts */
+	void ApplyRecordingSettings();
+
+	/** Rescales the checkpoint interval with the number of recorded network objects while recording */
+	bool UpdateCheckpointInterval(float DeltaTime);
+	float CalculateCheckpointInterval(int32 NumNetworkObjects) const;
+
+protected:
+	/** Checkpoint interval used for small worlds, in seconds */
+	UPROPERTY(Config)
+	float MinCheckpointInterval = 10.f;
+
+	/** Upper bound on the checkpoint interval, which bounds how far a seek has to fast forward */
+	UPROPERTY(Config)
+	float MaxCheckpointInterval = 30.f;
+
+	/** Number of network objects at which the interval starts growing past MinCheckpointInterval */
+	UPROPERTY(Config)
+	int32 CheckpointReferenceObjectCount = 500;
+
+	/** Checkpoints are written incrementally, spending at most this much of each frame on them */
+	UPROPERTY(Config)
+	float CheckpointSaveMaxMSPerFrame = 2.f;
+
+	/** Rate at which actors are recorded into the replay stream */
+	UPROPERTY(Config)
+	float RecordHz = 8.f;
+
+private:
+	bool bSeekInFlight = false;
+	float PendingSeekTime = -1.f;
+	float LastSeekTarget = 0.f;
+
+	FTSTicker::FDelegateHandle CheckpointIntervalTickerHandle;
 };
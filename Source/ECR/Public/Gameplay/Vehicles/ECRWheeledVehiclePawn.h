@@ -4,8 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemInterface.h"
+#include "GameplayEffectTypes.h"
 #include "GameplayTagAssetInterface.h"
 #include "WheeledVehiclePawn.h"
+#include "ChaosVehicleWheel.h"
 #include "Gameplay/Interaction/InteractionQuery.h"
 #include "Gameplay/Interaction/IInteractableTarget.h"
 #include "Gameplay/Player/ECRPlayerController.h"
@@ -19,6 +21,24 @@ class UECRPawnData;
 class UECRCombatSet;
 class UECRHealthSet;
 class UECRSimpleVehicleHealthSet;
+struct FGameplayEffectSpec;
+
+/**
+ * EECRVehicleSimulationLOD
+ *
+ *	Fidelity of the vehicle simulation on the server.
+ */
+UENUM(BlueprintType)
+enum class EECRVehicleSimulationLOD : uint8
+{
+	// Wheel sweeps as configured
+	Full = 0,
+	// Raycast suspension, for vehicles nobody drives or watches closely
+	Reduced,
+	// Parked, physics sleeps until something wakes the vehicle
+	Asleep
+};
+
 
 /**
  * 
@@ -50,6 +70,20 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	//~AActor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget,
+	                             UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+	virtual bool IsReplayRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation,
+	                                 const float CullDistance) const override;
+	//~End of AActor interface
+
+	EECRVehicleSimulationLOD GetSimulationLOD() const { return SimulationLOD; }
+
+	/** Set server simulation fidelity, a locked LOD isn't changed by the replication policy */
+	void SetSimulationLOD(EECRVehicleSimulationLOD NewLOD, bool bLock = false);
+
 protected:
 	virtual void OnAbilitySystemInitialized();
 	virtual void OnAbilitySystemUninitialized();
@@ -91,6 +125,72 @@ protected:
 	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery,
 										  FInteractionOptionBuilder& OptionBuilder) override;
 	//~End of IInteractableTarget interface
+
+	/** Adjust update frequency, cull distance and dormancy to occupancy, movement and distance to players */
+	void UpdateReplicationPolicy();
+
+	bool IsNearAnyViewer(float Distance) const;
+
+	void UpdateSimulationLOD(EECRVehicleSimulationLOD DesiredLOD);
+
+	/** Stop ticking the ability system of a vehicle nobody uses, dormancy keeps its replicated state */
+	void HibernateAbilitySystem();
+
+	/** Resume ability system tick */
+	void ResumeAbilitySystem();
+
+	void HandleGameplayEffectExecuted(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec,
+	                                  FActiveGameplayEffectHandle Handle);
+
+protected:
+	/** Update frequency of a driven vehicle near another player */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float DrivenNearNetUpdateFrequency = 100.0f;
+
+	/** Update frequency of a driven vehicle away from other players */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float DrivenNetUpdateFrequency = 30.0f;
+
+	/** Update frequency of a vehicle nobody drives that is still moving */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float UnoccupiedNetUpdateFrequency = 10.0f;
+
+	/** Update frequency of a parked vehicle before it goes dormant */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float ParkedNetUpdateFrequency = 2.0f;
+
+	/** Net cull distance of driven and moving vehicles */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float ActiveNetCullDistanceSquared = 900000000.0f;
+
+	/** Net cull distance of parked vehicles */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float ParkedNetCullDistanceSquared = 225000000.0f;
+
+	/** Players closer than this get the driven vehicle at full rate and higher priority */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float NearViewerDistance = 5000.0f;
+
+	/** Net priority multiplier of a driven vehicle for viewers within NearViewerDistance */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float DrivenNearViewerPriorityScale = 2.0f;
+
+	/** Vehicles not driven and further than this from every player use reduced simulation */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float FullSimulationDistance = 8000.0f;
+
+	/** Vehicles slower than this are at rest */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float ParkedSpeed = 10.0f;
+
+	/** Seconds a vehicle nobody drives has to be at rest before it goes dormant */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float DormancyDelay = 10.0f;
+
+	/** Seconds between replication policy updates */
+	UPROPERTY(EditDefaultsOnly, Category = "ECR|Vehicle|Replication")
+	float ReplicationPolicyInterval = 0.5f;
+
 private:
 	// The ability system component sub-object used by vehicles.
 	UPROPERTY(VisibleAnywhere, Category = "ECR|Vehicle")
@@ -109,6 +209,19 @@ private:
 		meta=(AllowPrivateAccess="true", ExposeOnSpawn="true"))
 	const UECRPawnData* PawnData;
 
+	FTimerHandle ReplicationPolicyTimerHandle;
+
+	float RestingTime = 0.0f;
+
+	bool bAbilitySystemHibernating = false;
+
+	EECRVehicleSimulationLOD SimulationLOD = EECRVehicleSimulationLOD::Full;
+
+	bool bSimulationLODLocked = false;
+
+	/** Sweep shapes wheels were set up with, restored at full simulation */
+	TArray<ESweepShape> ConfiguredSweepShapes;
+
 private:
 	UFUNCTION()
 	void OnRep_PawnData();
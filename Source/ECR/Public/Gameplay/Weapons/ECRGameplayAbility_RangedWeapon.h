@@ -53,6 +53,10 @@ public:
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	//~End of UGameplayAbility interface
 
+	// Wrapper around WeaponTrace to handle trying to do a ray trace before falling back to a sweep trace if there were no hits and SweepRadius is above zero 
+	FHitResult DoSingleBulletTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>&
+	                               OutHits, bool bSuppressDebugDraw = false) const;
+
 protected:
 	struct FRangedWeaponFiringInput
 	{
@@ -85,10 +89,6 @@ protected:
 	// Does a single weapon trace, either sweeping or ray depending on if SweepRadius is above zero
 	FHitResult WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const;
 
-	// Wrapper around WeaponTrace to handle trying to do a ray trace before falling back to a sweep trace if there were no hits and SweepRadius is above zero 
-	FHitResult DoSingleBulletTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>&
-	                               OutHits, bool bSuppressDebugDraw = false) const;
-
 	// Does single camera trace for targeting sources toward focus and returns location to aim to
 	FVector GetSingleCameraTraceHitLocation(APawn* const AvatarPawn, UECRRangedWeaponInstance* WeaponData) const;
 
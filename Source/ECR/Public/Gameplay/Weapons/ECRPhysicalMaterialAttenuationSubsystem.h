@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "ECRPhysicalMaterialAttenuationSubsystem.generated.h"
+
+class UECRRangedWeaponInstance;
+class UPhysicalMaterial;
+
+/**
+ * UECRPhysicalMaterialAttenuationSubsystem
+ *
+ *	Combined MaterialDamageMultiplier of physical materials, baked once per ranged weapon class and world so damage
+ *	executions don't have to match tags. Materials of levels added to the world later are added to every table,
+ *	tables of recompiled Blueprint weapons are dropped and baked again on the next equip.
+ */
+UCLASS()
+class UECRPhysicalMaterialAttenuationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Returns the table of the weapon class, baked from its defaults for all loaded physical materials */
+	TSharedRef<const TMap<TObjectKey<UPhysicalMaterial>, float>> GetTable(
+		TSubclassOf<UECRRangedWeaponInstance> WeaponClass);
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	static void AddLoadedMaterials(const UECRRangedWeaponInstance* WeaponCDO,
+	                               TMap<TObjectKey<UPhysicalMaterial>, float>& Table);
+
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+#if WITH_EDITOR
+	void HandleObjectsReplaced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+#endif
+
+private:
+	TMap<TObjectKey<UClass>, TSharedRef<TMap<TObjectKey<UPhysicalMaterial>, float>>> TablesByClass;
+
+	FDelegateHandle LevelAddedToWorldHandle;
+
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReplacedHandle;
+#endif
+};
@@ -4,12 +4,38 @@
 
 #include "CoreMinimal.h"
 #include "Curves/CurveFloat.h"
+#include "UObject/ObjectKey.h"
 
 #include "ECRWeaponInstance.h"
 
 #include "ECRRangedWeaponInstance.generated.h"
 
 class UPhysicalMaterial;
+class UAbilitySystemComponent;
+
+/**
+ * FECRHeatLookupTable
+ *
+ * A value sampled at evenly spaced heat values, used instead of evaluating the heat curves at runtime
+ */
+struct FECRHeatLookupTable
+{
+	void Reset(float InMinHeat, float InMaxHeat, int32 NumSamples);
+
+	bool IsValid() const
+	{
+		return Values.Num() > 0;
+	}
+
+	float Eval(float Heat) const;
+
+	// Inverse of Eval, only valid when the values are non-decreasing
+	float FindHeatForValue(float Value) const;
+
+	float MinHeat = 0.0f;
+	float HeatStep = 0.0f;
+	TArray<float> Values;
+};
 
 /**
  * UECRRangedWeaponInstance
@@ -24,6 +50,7 @@ class UECRRangedWeaponInstance : public UECRWeaponInstance
 public:
 	UECRRangedWeaponInstance(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual void PostInitProperties() override;
 	virtual void PostLoad() override;
 
 #if WITH_EDITOR
@@ -38,26 +65,17 @@ public:
 	}
 
 	/** Returns the current spread angle (in degrees, diametrical) */
-	float GetCalculatedSpreadAngle() const
-	{
-		return CurrentSpreadAngle;
-	}
+	float GetCalculatedSpreadAngle() const;
 
 	float GetCalculatedSpreadAngleMultiplier() const
 	{
-		return bHasFirstShotAccuracy ? 0.0f : CurrentSpreadAngleMultiplier;
+		return HasFirstShotAccuracy() ? 0.0f : CurrentSpreadAngleMultiplier;
 	}
 
 	UFUNCTION(BlueprintCallable, BlueprintPure)
-	float GetCurrentHeat() const
-	{
-		return CurrentHeat;
-	}
+	float GetCurrentHeat() const;
 
-	bool HasFirstShotAccuracy() const
-	{
-		return bHasFirstShotAccuracy;
-	}
+	bool HasFirstShotAccuracy() const;
 
 	float GetSpreadExponent() const
 	{
@@ -204,15 +222,46 @@ protected:
 	TMap<FGameplayTag, float> MaterialDamageMultiplier;
 
 private:
-	// The current heat
-	UPROPERTY(Replicated)
+	// Heat at the moment it was last changed by a shot or RemoveHeat, it cools down from there on
+	UPROPERTY(ReplicatedUsing=OnRep_CurrentHeat)
 	float CurrentHeat = 0.0f;
 
-	// The current spread angle (in degrees, diametrical)
-	float CurrentSpreadAngle = 0.0f;
+	// Incremented on every heat change so clients restart cooldown even if the heat value is the same
+	UPROPERTY(ReplicatedUsing=OnRep_CurrentHeat)
+	uint8 HeatRevision = 0;
+
+	// World time at which CurrentHeat starts cooling down
+	double HeatCooldownStartTime = 0.0;
+
+	// Heat curves baked over the heat range
+	FECRHeatLookupTable SpreadByHeat;
+	FECRHeatLookupTable HeatPerShotByHeat;
+
+	// Time it takes to cool down from a given heat to the minimum heat
+	FECRHeatLookupTable CooldownTimeByHeat;
+
+	// Cached curve ranges
+	float MinHeatRange = 0.0f;
+	float MaxHeatRange = 0.0f;
+	float MinSpreadRange = 0.0f;
+	float MaxSpreadRange = 0.0f;
+
+	// Combined MaterialDamageMultiplier of physical materials, shared by all weapons of the class in this world
+	TSharedPtr<const TMap<TObjectKey<UPhysicalMaterial>, float>> PhysicalMaterialAttenuationTable;
+
+	// Are the movement and tag driven multipliers at their minimum?
+	bool bMultipliersAtMin = true;
+
+	// Set when an input of the multipliers changed outside of the movement state
+	bool bMultipliersDirty = true;
+
+	// Aiming and bracing states, updated from ability system tag events
+	bool bIsAiming = false;
+	bool bIsBracing = false;
 
-	// Do we currently have first shot accuracy?
-	bool bHasFirstShotAccuracy = false;
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+	FDelegateHandle AimingTagChangedHandle;
+	FDelegateHandle BracingTagChangedHandle;
 
 	// The current *combined* spread angle multiplier
 	float CurrentSpreadAngleMultiplier = 1.0f;
@@ -255,18 +304,35 @@ private:
 	void ComputeSpreadRange(float& MinSpread, float& MaxSpread);
 	void ComputeHeatRange(float& MinHeat, float& MaxHeat);
 
-	inline float ClampHeat(float NewHeat)
+	inline float ClampHeat(float NewHeat) const
 	{
-		float MinHeat;
-		float MaxHeat;
-		ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
-
-		return FMath::Clamp(NewHeat, MinHeat, MaxHeat);
+		return FMath::Clamp(NewHeat, MinHeatRange, MaxHeatRange);
 	}
 
-	// Updates the spread and returns true if the spread is at minimum
-	bool UpdateSpread(float DeltaSeconds);
+	// Samples the heat curves into lookup tables
+	void BakeHeatCurves();
+
+	// Takes the physical material attenuation table of this class from the world
+	void BakePhysicalMaterialAttenuation();
+
+	float CalculatePhysicalMaterialAttenuation(const UPhysicalMaterial* PhysicalMaterial) const;
+
+	// Returns the heat at the given world time, cooling down from CurrentHeat
+	float GetHeatAtTime(double WorldTime) const;
+
+	// Sets the heat at the current time and restarts the cooldown after the given delay
+	void SetHeat(float NewHeat, float CooldownDelay);
+
+	UFUNCTION()
+	void OnRep_CurrentHeat();
 
 	// Updates the multipliers and returns true if they are at minimum
 	bool UpdateMultipliers(float DeltaSeconds);
+
+	void BindToAbilitySystemTags();
+	void UnbindFromAbilitySystemTags();
+	void OnAimingTagChanged(const FGameplayTag Tag, int32 NewCount);
+	void OnBracingTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	friend class UECRPhysicalMaterialAttenuationSubsystem;
 };
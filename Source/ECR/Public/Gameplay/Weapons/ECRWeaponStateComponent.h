@@ -11,6 +11,8 @@
 struct FGameplayAbilityTargetDataHandle;
 struct FGameplayEffectContextHandle;
 struct FHitResult;
+class UECREquipmentManagerComponent;
+class APawn;
 
 UENUM()
 enum EHitSuccess
@@ -25,26 +27,20 @@ enum EHitSuccess
 // A 'successful' hit marker is shown for impacts that damaged an enemy
 struct FECRScreenSpaceHitLocation
 {
-	/** Hit location in viewport screenspace */
-	FVector2D Location;
+	/** Hit location in world space */
+	FVector WorldLocation = FVector::ZeroVector;
+	/** Hit location in viewport screenspace, only filled in when the HUD projects the markers for drawing */
+	FVector2D Location = FVector2D::ZeroVector;
 	FGameplayTag HitZone;
 	EHitSuccess HitSuccess = None;
 };
 
 struct FECRServerSideHitMarkerBatch
 {
-	FECRServerSideHitMarkerBatch()
-	{
-	}
-
-	FECRServerSideHitMarkerBatch(uint8 InUniqueId) :
-		UniqueId(InUniqueId)
-	{
-	}
-
 	TArray<FECRScreenSpaceHitLocation> Markers;
 
-	uint8 UniqueId = 0;
+	/** World time the batch was added, unconfirmed batches expire after a while */
+	double CreationTime = 0.0;
 };
 
 // Tracks weapon state and recent confirmed hit markers to display on screen
@@ -69,10 +65,10 @@ public:
 	/** Updates this player's last damage instigated time */
 	void UpdateDamageInstigatedTime(const FGameplayEffectContextHandle& EffectContext);
 
-	/** Gets the array of most recent locations this player instigated damage, in screen-space */
-	void GetLastWeaponDamageScreenLocations(TArray<FECRScreenSpaceHitLocation>& WeaponDamageScreenLocations)
+	/** Gets the most recent locations this player instigated damage, in world space. The HUD projects them when drawing. */
+	const TArray<FECRScreenSpaceHitLocation>& GetLastWeaponDamageLocations() const
 	{
-		WeaponDamageScreenLocations = LastWeaponDamageScreenLocations;
+		return LastWeaponDamageLocations;
 	}
 
 	/** Returns the elapsed time since the last (outgoing) damage hit notification occurred */
@@ -95,13 +91,28 @@ protected:
 
 	void ActuallyUpdateDamageInstigatedTime();
 
+	/** Drops unconfirmed hit marker batches the server never answered */
+	void RemoveExpiredUnconfirmedHitMarkers();
+
+	/** Returns the equipment manager of the controlled pawn, looked up again only when the pawn changes */
+	UECREquipmentManagerComponent* GetPawnEquipmentManager();
+
 private:
+	/** Pawn the equipment manager was cached for */
+	TWeakObjectPtr<APawn> CachedPawn;
+
+	/** Equipment manager of CachedPawn */
+	TWeakObjectPtr<UECREquipmentManagerComponent> CachedEquipmentManager;
+
 	/** Last time this controller instigated weapon damage */
 	double LastWeaponDamageInstigatedTime = 0.0;
 
-	/** Screen-space locations of our most recently instigated weapon damage (the confirmed hits) */
-	TArray<FECRScreenSpaceHitLocation> LastWeaponDamageScreenLocations;
+	/** Locations of our most recently instigated weapon damage (the confirmed hits) */
+	TArray<FECRScreenSpaceHitLocation> LastWeaponDamageLocations;
+
+	/** The unconfirmed hits, keyed by the target data unique id */
+	TMap<uint16, FECRServerSideHitMarkerBatch> UnconfirmedServerSideHitMarkers;
 
-	/** The unconfirmed hits */
-	TArray<FECRServerSideHitMarkerBatch> UnconfirmedServerSideHitMarkers;
+	/** Next world time unconfirmed hit markers get checked for expiry */
+	double NextUnconfirmedHitMarkerExpiryCheckTime = 0.0;
 };
@@ -7,6 +7,9 @@
 #include "FindSessionsCallbackProxy.h"
 #include "ECROnlineSubsystem.generated.h"
 
+class FOnlineSessionSettings;
+class FOnlineSessionSearch;
+
 
 /** Alliance of factions (eg LSM & Eldar) */
 USTRUCT(BlueprintType)
@@ -22,6 +25,42 @@ struct FFactionAlliance
 };
 
 
+/**
+ * Versioned layout of match data in session settings. Values used in search queries are advertised as separate
+ * attributes, everything else is packed into a single binary attribute validated on read
+ */
+struct ECR_API FECRMatchAdvertisement
+{
+	/** Bump on any change of the advertised layout, sessions of other schemas aren't returned by searches */
+	static constexpr uint8 SchemaVersion = 1;
+
+	FString GameVersion;
+	FName GameMode;
+	FName MapName;
+	FName GameMission;
+	FName Region;
+	FName WeatherName;
+	FName DayTimeName;
+	FString UserDisplayName;
+	TArray<FFactionAlliance> Alliances;
+	TMap<FName, FText> FactionNamesToShortTexts;
+	int32 CurrentPlayerAmount = 0;
+	double MatchStartedTime = 0.0;
+
+	/** Set match attributes of session settings */
+	void Write(FOnlineSessionSettings& SessionSettings) const;
+
+	/** Returns false if settings were advertised with another schema or are malformed */
+	bool Read(const FOnlineSessionSettings& SessionSettings);
+
+	/** Get factions string (like "SM, Eldar vs CSM") **/
+	FString GetFactionsString() const;
+
+	/** Limit search to sessions advertised with this schema */
+	static void AddSchemaQuery(FOnlineSessionSearch& Search);
+};
+
+
 /** Data about match that will be available in match search */
 USTRUCT(BlueprintType)
 // ReSharper disable once CppUE4CodingStandardNamingViolationWarning
@@ -56,9 +95,15 @@ struct FECRMatchResult
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	FName DayTime;
 
-	/** For some reason getting int in EOS doesn't work */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-	FString CurrentPlayerAmount;
+	int32 CurrentPlayerAmount;
+
+	/** CurrentPlayerAmount for widgets to display */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FString CurrentPlayerAmountString;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 MaxPlayerAmount;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	double MatchStartedTimestamp;
@@ -68,6 +113,16 @@ struct FECRMatchResult
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	FString UserDisplayName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FString SessionId;
+
+	/** Whether match settings were read successfully, results of incompatible builds aren't */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bIsValid;
+
+	/** Update only the settings that change during a match, for refreshing an already parsed result */
+	bool UpdateDynamicSettings(const FOnlineSessionSearchResult& SearchResult);
 };
 
 
@@ -0,0 +1,84 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Online/ECROnlineSubsystem.h"
+#include "ECRQuickPlayScorer.generated.h"
+
+
+/** What the player would like from a quick play match, empty values have no preference */
+USTRUCT(BlueprintType)
+struct FECRQuickPlayPreferences
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Region;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Faction;
+};
+
+
+/** Session found by a quick play search, independent of online subsystem types */
+USTRUCT(BlueprintType)
+struct FECRQuickPlayCandidate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 PingInMs = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 CurrentPlayerAmount = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxPlayerAmount = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Region;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FFactionAlliance> Alliances;
+};
+
+
+/**
+ * Ranks quick play candidates by ping, fill level, region and faction balance. Works on plain candidate structs
+ * only, so it can be fed synthetic session lists. Subclass and set as QuickPlayScorerClass for other criteria
+ */
+UCLASS(Config=Game)
+// ReSharper disable once CppUE4CodingStandardNamingViolationWarning
+class ECR_API UECRQuickPlayScorer : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Score in 0..1 range, negative if the session shouldn't be joined at all */
+	virtual float ScoreCandidate(const FECRQuickPlayCandidate& Candidate, const FECRQuickPlayPreferences& Preferences) const;
+
+	/** Indices of joinable candidates with their scores, from best to worst */
+	void RankCandidates(const TArray<FECRQuickPlayCandidate>& Candidates, const FECRQuickPlayPreferences& Preferences,
+	                    TArray<TPair<int32, float>>& OutRanking) const;
+
+protected:
+	UPROPERTY(Config, EditDefaultsOnly)
+	float PingWeight = 1.f;
+
+	/** Partially filled sessions are preferred over empty ones, so players consolidate on fewer servers */
+	UPROPERTY(Config, EditDefaultsOnly)
+	float FillWeight = 1.f;
+
+	UPROPERTY(Config, EditDefaultsOnly)
+	float RegionWeight = 0.5f;
+
+	/** Preferred faction participating and alliances being of even strength */
+	UPROPERTY(Config, EditDefaultsOnly)
+	float FactionWeight = 0.5f;
+
+	/** Sessions with higher ping are never joined */
+	UPROPERTY(Config, EditDefaultsOnly)
+	int32 MaxAcceptablePing = 250;
+};
@@ -0,0 +1,101 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "Online/ECROnlineSubsystem.h"
+
+class FOnlineSessionSearch;
+
+
+/** Server-side filter of a session browser search, empty values aren't filtered */
+struct ECR_API FECRSessionBrowserFilter
+{
+	FString GameVersion;
+	FString Mission;
+	FString Mode;
+	FString MapName;
+	FString Region;
+
+	/** Every listed faction has to participate in the match */
+	TArray<FName> Factions;
+
+	bool operator==(const FECRSessionBrowserFilter& Other) const;
+	bool operator!=(const FECRSessionBrowserFilter& Other) const { return !(*this == Other); }
+
+	/** Adds the query settings of this filter to the search */
+	void ApplyTo(FOnlineSessionSearch& Search) const;
+};
+
+
+/**
+ * FECRSessionBrowser
+ *
+ *	Cache of parsed session search results. Refreshes are merged into the cached set by session id, so already
+ *	listed sessions keep their entry and position while a search is in flight and only get their updatable settings
+ *	re-read. A session is dropped after missing from several consecutive refreshes. Works with any session interface,
+ *	so it can be driven by the NULL online subsystem (LAN beacon) for local testing.
+ */
+class ECR_API FECRSessionBrowser : public TSharedFromThis<FECRSessionBrowser>
+{
+public:
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnResultsUpdated, bool /*bWasSuccessful*/);
+
+	explicit FECRSessionBrowser(const IOnlineSessionPtr& InSessionInterface, bool bInIsLanQuery = false);
+	~FECRSessionBrowser();
+
+	/** Sets the search filter, cached results are dropped if it differs from the current one */
+	void SetFilter(const FECRSessionBrowserFilter& InFilter);
+
+	const FECRSessionBrowserFilter& GetFilter() const { return Filter; }
+
+	/** Starts a search unless one is already in flight, returns false if it couldn't be started */
+	bool Refresh();
+
+	/** Refresh in the background every Interval seconds until stopped */
+	void StartAutoRefresh(float Interval);
+	void StopAutoRefresh();
+
+	bool IsRefreshing() const { return ActiveSearch.IsValid(); }
+
+	/** Seconds since the last successful refresh with the current filter, negative if there wasn't one */
+	double GetResultsAge() const;
+
+	const TArray<FECRMatchResult>& GetResults() const { return Results; }
+
+	/** Broadcast when a refresh completes */
+	FOnResultsUpdated OnResultsUpdated;
+
+private:
+	void HandleFindSessionsComplete(bool bWasSuccessful);
+	bool HandleAutoRefresh(float DeltaTime);
+
+	void ClearResults();
+	void MergeResults(const TArray<FOnlineSessionSearchResult>& SearchResults);
+
+private:
+	TWeakPtr<IOnlineSession, ESPMode::ThreadSafe> SessionInterface;
+	bool bIsLanQuery;
+
+	FECRSessionBrowserFilter Filter;
+
+	/** Incremented on every filter change, results of a search started with an older filter are discarded */
+	uint32 FilterSerial = 0;
+	uint32 ActiveSearchFilterSerial = 0;
+	TSharedPtr<FOnlineSessionSearch> ActiveSearch;
+
+	TArray<FECRMatchResult> Results;
+
+	/** Consecutive refreshes each cached result was missing from, parallel to Results */
+	TArray<uint8> MissedRefreshes;
+
+	/** Session id to index in Results */
+	TMap<FString, int32> ResultIndices;
+
+	double LastRefreshTime = -1.0;
+
+	FDelegateHandle FindSessionsCompleteHandle;
+	FTSTicker::FDelegateHandle AutoRefreshHandle;
+};
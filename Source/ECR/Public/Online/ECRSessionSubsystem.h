@@ -0,0 +1,84 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonSessionSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Online/ECRQuickPlayScorer.h"
+#include "ECRSessionSubsystem.generated.h"
+
+
+/**
+ * Game-specific session subsystem. Quick play ranks found sessions with a UECRQuickPlayScorer instead of joining the
+ * first one, searches again with a lower score requirement if nothing good enough was found, and hosts a session
+ * when searches are exhausted
+ */
+UCLASS(Config=Game)
+// ReSharper disable once CppUE4CodingStandardNamingViolationWarning
+class ECR_API UECRSessionSubsystem : public UCommonSessionSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~UCommonSessionSubsystem interface
+	virtual void QuickPlaySession(APlayerController* JoiningOrHostingPlayer, UCommonSession_HostSessionRequest* Request) override;
+	//~End of UCommonSessionSubsystem interface
+
+	/** Set region and faction quick play should prefer */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void SetQuickPlayPreferences(const FECRQuickPlayPreferences& Preferences) { QuickPlayPreferences = Preferences; }
+
+	/** Build scorer candidates from search results, results of incompatible builds are skipped */
+	static void GetQuickPlayCandidates(const TArray<UCommonSession_SearchResult*>& Results,
+	                                   TArray<FECRQuickPlayCandidate>& OutCandidates,
+	                                   TArray<UCommonSession_SearchResult*>& OutCandidateResults);
+
+protected:
+	//~UCommonSessionSubsystem interface
+	virtual TSharedRef<FCommonOnlineSearchSettings> CreateQuickPlaySearchSettings(UCommonSession_HostSessionRequest* Request, UCommonSession_SearchSessionRequest* QuickPlayRequest) override;
+	virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest) override;
+	//~End of UCommonSessionSubsystem interface
+
+	/** Scorer used to rank quick play sessions */
+	UPROPERTY(Config)
+	TSoftClassPtr<UECRQuickPlayScorer> QuickPlayScorerClass;
+
+	/** Score required to join a session on the first search */
+	UPROPERTY(Config)
+	float MinQuickPlayScore = 0.6f;
+
+	/** How much the required score is lowered for every search after the first */
+	UPROPERTY(Config)
+	float QuickPlayScoreRelaxPerSearch = 0.2f;
+
+	/** Searches done before hosting a session */
+	UPROPERTY(Config)
+	int32 MaxQuickPlaySearches = 3;
+
+	/** Seconds between quick play searches, so new sessions and player counts have time to show up */
+	UPROPERTY(Config)
+	float QuickPlaySearchRetryDelay = 2.f;
+
+private:
+	void StartQuickPlaySearch(APlayerController* JoiningOrHostingPlayer, UCommonSession_HostSessionRequest* Request);
+
+private:
+	UPROPERTY()
+	TObjectPtr<UECRQuickPlayScorer> QuickPlayScorer;
+
+	/** Request of the quick play search in flight, the base class only exposes it as an opaque type */
+	UPROPERTY()
+	TObjectPtr<UCommonSession_SearchSessionRequest> QuickPlaySearchRequest;
+
+	FECRQuickPlayPreferences QuickPlayPreferences;
+
+	int32 QuickPlaySearchCount = 0;
+
+	FTSTicker::FDelegateHandle QuickPlayRetryHandle;
+};
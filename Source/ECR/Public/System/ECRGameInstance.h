@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "Engine/GameInstance.h"
 #include "Online/ECROnlineSubsystem.h"
 #include "ECRGameInstance.generated.h"
@@ -29,12 +30,27 @@ class ECR_API UECRGameInstance : public UGameInstance
 	/** Whether user is logged in */
 	bool bIsLoggedIn;
 
-	/** Session search object */
-	TSharedPtr<class FOnlineSessionSearch> SessionSearchSettings;
+	/** Cached server list, created on first search */
+	TSharedPtr<class FECRSessionBrowser> SessionBrowser;
 
-	/** Get factions string (like "SM, Eldar vs CSM") **/
-	static FString GetMatchFactionString(const TArray<FFactionAlliance>& FactionAlliances,
-	                                     const TMap<FName, FText>& FactionNamesToShortTexts);
+	/** Get session browser, creating it if needed */
+	FECRSessionBrowser* GetSessionBrowser();
+
+	/** Advertised settings changed since the last push to the online service */
+	bool bSessionAdvertisementDirty = false;
+
+	bool bSessionAdvertisementUpdateInFlight = false;
+
+	double LastSessionAdvertisementUpdateTime = -1.0e9;
+
+	FTSTicker::FDelegateHandle SessionAdvertisementTickerHandle;
+
+	FDelegateHandle UpdateSessionCompleteHandle;
+
+	/** Push pending session settings changes */
+	bool FlushSessionSettings(float DeltaTime);
+
+	void OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful);
 
 protected:
 	/** Login via selected login type */
@@ -49,7 +65,7 @@ protected:
 	/** When OnCreateMatchComplete fires, save match creation parameters and travel to match map */
 	void OnCreateMatchComplete(FName SessionName, bool bWasSuccessful);
 
-	/** When OnFindSessionsComplete fires, pass matches data to GUISupervisor */
+	/** When session browser refresh completes, pass matches data to GUISupervisor */
 	void OnFindMatchesComplete(bool bWasSuccessful);
 
 	/** When OnJoinSessionComplete fires, travel to the session map */
@@ -87,15 +103,26 @@ public:
 	                 const FName DayTimeName, const TArray<FFactionAlliance> Alliances, const TMap<FName, int32>
 	                 FactionNamesToCapacities, const TMap<FName, FText> FactionNamesToShortTexts);
 
-	/** Create match, by player (P2P) or dedicated server */
-	UFUNCTION(BlueprintCallable)
-	void FindMatches(const FString GameVersion = "", const FString MatchType = "",
+	/** Find matches created by player (P2P) or dedicated server. Cached results matching the filter are passed to
+	 * GUISupervisor right away, then again when the refresh completes. Factions have to all participate, the
+	 * array comes first as it can't have a C++ default value */
+	UFUNCTION(BlueprintCallable, meta=(AutoCreateRefTerm="Factions"))
+	void FindMatches(const TArray<FName>& Factions, const FString GameVersion = "", const FString MatchType = "",
 	                 const FString MatchMode = "", const FString MapName = "", const FString RegionName = "");
 
+	/** Keep refreshing the last match search in background while the server list is open */
+	UFUNCTION(BlueprintCallable)
+	void StartMatchListAutoRefresh(float Interval = 15.f);
+
+	UFUNCTION(BlueprintCallable)
+	void StopMatchListAutoRefresh();
+
 	/** Join match */
 	UFUNCTION(BlueprintCallable)
 	void JoinMatch(FBlueprintSessionResult Session);
 
+	/** Push session settings to the online service, changes are batched to at most one update per
+	 * ECR.SessionAdvertisement.MinUpdateInterval */
 	UFUNCTION(BlueprintCallable)
 	void UpdateSessionSettings();
 
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ECRServerStatsSubsystem.generated.h"
+
+class FSocket;
+
+/** Fixed size log-scale histogram of durations, three buckets per power of two starting at 1us (~2s range) */
+struct ECR_API FECRServerStatHistogram
+{
+	static constexpr int32 NumBuckets = 64;
+	static constexpr int32 BucketsPerOctave = 3;
+
+	void Add(double Microseconds);
+	void Reset();
+
+	/** Upper bound of the bucket containing the given percentile (0..1), clamped to the largest recorded value */
+	double GetPercentile(double Percentile) const;
+
+	uint32 Count = 0;
+	double MaxMicroseconds = 0.0;
+	double TotalMicroseconds = 0.0;
+	uint32 Buckets[NumBuckets] = {};
+};
+
+/**
+ * FECRServerStats
+ *
+ *	Registry of named timing scopes sampled on the server game thread. Recording is a no-op unless
+ *	the server stats subsystem is running, so scopes can stay in hot paths in every build.
+ */
+class ECR_API FECRServerStats
+{
+public:
+	static int32 RegisterScope(const TCHAR* Name);
+
+	static void Record(int32 ScopeIndex, double Microseconds);
+
+	static bool IsEnabled() { return bEnabled; }
+
+private:
+	friend class UECRServerStatsSubsystem;
+
+	struct FScope
+	{
+		FString Name;
+		FECRServerStatHistogram Histogram;
+	};
+
+	static TArray<FScope>& GetScopes();
+
+	static bool bEnabled;
+};
+
+/** Times the enclosing block into a registered server stat scope */
+struct FECRServerStatScope
+{
+	explicit FECRServerStatScope(int32 InScopeIndex)
+		: ScopeIndex(InScopeIndex)
+		, StartCycles(FECRServerStats::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FECRServerStatScope()
+	{
+		if (StartCycles != 0)
+		{
+			FECRServerStats::Record(ScopeIndex, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+		}
+	}
+
+private:
+	int32 ScopeIndex;
+	uint64 StartCycles;
+};
+
+#define ECR_SERVER_STAT_SCOPE(Name) \
+	static const int32 PREPROCESSOR_JOIN(ECRServerStatIndex_, __LINE__) = FECRServerStats::RegisterScope(TEXT(#Name)); \
+	FECRServerStatScope PREPROCESSOR_JOIN(ECRServerStatScope_, __LINE__)(PREPROCESSOR_JOIN(ECRServerStatIndex_, __LINE__))
+
+/**
+ * UECRServerStatsSubsystem
+ *
+ *	Lightweight frame profiler for dedicated servers. Samples the frame, the replication window and every
+ *	ECR_SERVER_STAT_SCOPE into histograms, and periodically writes p50/p90/p99/max summaries to a CSV in the
+ *	profiling directory and, if a port is set, as text datagrams to a loopback UDP endpoint.
+ */
+UCLASS()
+class UECRServerStatsSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Writes the current summaries and starts a new window */
+	void Flush();
+
+private:
+	bool HandleTicker(float DeltaTime);
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandlePostTickFlush(float DeltaSeconds);
+
+	void SendToLoopback(const FString& Text);
+
+private:
+	FString OutputFilePath;
+	FSocket* LoopbackSocket = nullptr;
+	int32 LoopbackPort = 0;
+
+	double LastFlushTime = 0.0;
+	uint64 FrameStartCycles = 0;
+	uint64 ReplicationStartCycles = 0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle PostTickFlushHandle;
+	TWeakObjectPtr<UWorld> PostTickFlushWorld;
+};
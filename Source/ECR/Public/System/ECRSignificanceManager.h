@@ -6,9 +6,87 @@
 #include "SignificanceManager.h"
 #include "ECRSignificanceManager.generated.h"
 
-UCLASS()
-class UECRSignificanceManager : public USignificanceManager
+class ACharacter;
+
+/** Animation update rate used from a significance level up */
+USTRUCT()
+struct FECRAnimUpdateRateThreshold
 {
 	GENERATED_BODY()
 
-};
\ No newline at end of file
+	FECRAnimUpdateRateThreshold()
+	{
+	}
+
+	FECRAnimUpdateRateThreshold(const float InMinSignificance, const int32 InUpdateRate)
+		: MinSignificance(InMinSignificance)
+		, UpdateRate(InUpdateRate)
+	{
+	}
+
+	UPROPERTY()
+	float MinSignificance = 0.f;
+
+	/** Frames between animation updates, skipped frames are interpolated */
+	UPROPERTY()
+	int32 UpdateRate = 1;
+};
+
+/**
+ * UECRSignificanceManager
+ *
+ *	Rates characters by distance to the local viewpoints and whether they were rendered recently. Significance
+ *	is updated every frame from the viewpoints of local players and drives the animation update rate of
+ *	characters. Characters with no significance don't update their skeleton at all.
+ */
+UCLASS(Config=Game)
+class ECR_API UECRSignificanceManager : public USignificanceManager
+{
+	GENERATED_BODY()
+
+public:
+	static const FName CharacterTag;
+
+	UECRSignificanceManager();
+
+	//~UObject interface
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+	//~End of UObject interface
+
+	void RegisterCharacter(ACharacter* Character);
+
+	/** Significance in 0..1 range of a character seen from the viewpoint, 0 if it is too far to matter */
+	float CalculateCharacterSignificance(const FVector& CharacterLocation, bool bRecentlyRendered,
+	                                     const FTransform& Viewpoint) const;
+
+	/** Frames between animation updates for the significance, 0 if animation shouldn't be updated */
+	int32 GetAnimUpdateRate(float Significance) const;
+
+	float GetMaxSignificanceDistance() const { return MaxSignificanceDistance; }
+
+protected:
+	/** Characters further from every viewpoint have no significance */
+	UPROPERTY(Config)
+	float MaxSignificanceDistance = 15000.f;
+
+	/** Significance multiplier for characters that weren't rendered recently, occluded or behind the camera */
+	UPROPERTY(Config)
+	float NotRenderedSignificanceScale = 0.25f;
+
+	/** Seconds since last render for a character to be considered not rendered */
+	UPROPERTY(Config)
+	float RecentlyRenderedTolerance = 0.2f;
+
+	/** Sorted from highest to lowest significance */
+	UPROPERTY(Config)
+	TArray<FECRAnimUpdateRateThreshold> AnimUpdateRateThresholds;
+
+private:
+	void HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+private:
+	FDelegateHandle PostActorTickHandle;
+
+	TArray<FTransform> Viewpoints;
+};
@@ -1,15 +1,14 @@
 ﻿#pragma once
 
 
+// Filterable match settings, advertised as separate attributes to be usable in search queries
 #define SETTING_GAME_MISSION FName(TEXT("GAMEMISSION"))
 #define SETTING_REGION FName(TEXT("REGION"))
 #define SETTING_FACTION_PREFIX FName(TEXT("FACTION_"))
-#define SETTING_FACTIONS FName(TEXT("FACTIONS"))
 #define SETTING_GAME_VERSION FName(TEXT("GAMEVERSION"))
-#define SETTING_CURRENT_PLAYER_AMOUNT FName(TEXT("CURRENTPLAYERAMOUNT"))
-#define SETTING_STARTED_TIME FName(TEXT("MATCHSTARTEDTIME"))
-#define SETTING_USER_DISPLAY_NAME FName(TEXT("USERDISPLAYNAME"))
-#define SETTING_WEATHER_NAME FName(TEXT("WEATHER"))
-#define SETTING_DAYTIME_NAME FName(TEXT("DAYTIME"))
+#define SETTING_MATCH_SCHEMA FName(TEXT("MATCHSCHEMA"))
+
+// Everything else, packed by FECRMatchAdvertisement
+#define SETTING_MATCH_DATA FName(TEXT("MATCHDATA"))
 
 #define DEFAULT_SESSION_NAME FName(TEXT("DEFAULT_SESSION_NAME"))
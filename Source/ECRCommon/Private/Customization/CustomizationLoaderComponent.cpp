@@ -9,6 +9,7 @@
 #include "Customization/CustomizationMaterialNameSpace.h"
 #include "CustomizationUtilsLibrary.h"
 #include "MeshMergeFunctionLibrary.h"
+#include "ServerCosmeticsFilter.h"
 #include "Kismet/KismetSystemLibrary.h"
 
 
@@ -16,6 +17,7 @@ UCustomizationLoaderComponent::UCustomizationLoaderComponent()
 {
 	bInheritParentAnimations = true;
 	bUseParentSkeleton = true;
+	bCosmeticOnly = false;
 	bLoadOnBeginPlay = false;
 }
 
@@ -58,6 +60,11 @@ SceneComponentClass* UCustomizationLoaderComponent::SpawnChildComponent(USkeleta
 void UCustomizationLoaderComponent::LoadFromAsset(TArray<UCustomizationElementaryAsset*> NewElementaryAssets,
                                                   TArray<UCustomizationMaterialAsset*> NewMaterialConfigs)
 {
+	if (bCosmeticOnly && FServerCosmeticsFilter::ShouldSkip(TEXT("CustomizationLoad")))
+	{
+		return;
+	}
+
 	// Setting new elementary assets if passed or old from config
 	TArray<UCustomizationElementaryAsset*> ElementaryAssets;
 	if (!NewElementaryAssets.IsEmpty())
@@ -98,17 +105,20 @@ void UCustomizationLoaderComponent::LoadFromAsset(TArray<UCustomizationElementar
 		return;
 	}
 
-	// Material namespace data
+	// Material namespace data, left empty on dedicated servers so no material changes are applied
 	TMap<FString, UCustomizationMaterialAsset*> MaterialNamespacesToData;
-	for (UCustomizationMaterialAsset* Config : MaterialConfigs)
+	if (!FServerCosmeticsFilter::ShouldSkip(TEXT("CustomizationMaterials"), MaterialConfigs.Num()))
 	{
-		if (!Config)
+		for (UCustomizationMaterialAsset* Config : MaterialConfigs)
 		{
-			UE_LOG(LogAssetData, Warning, TEXT("Material config is null on %s"), *(GetNameSafe(GetOwner())));
-			continue;
-		}
+			if (!Config)
+			{
+				UE_LOG(LogAssetData, Warning, TEXT("Material config is null on %s"), *(GetNameSafe(GetOwner())));
+				continue;
+			}
 
-		MaterialNamespacesToData.Add(Config->MaterialNamespace, Config);
+			MaterialNamespacesToData.Add(Config->MaterialNamespace, Config);
+		}
 	}
 
 	// Fill array of modules for attachment and merge 
@@ -1,6 +1,7 @@
 ﻿#include "Customization/CustomizationMaterialLoaderComponent.h"
 #include "Customization/CustomizationMaterialNameSpace.h"
 #include "Customization/CustomizationUtilsLibrary.h"
+#include "ServerCosmeticsFilter.h"
 
 UCustomizationMaterialLoaderComponent::UCustomizationMaterialLoaderComponent()
 {
@@ -24,6 +25,11 @@ void UCustomizationMaterialLoaderComponent::LoadMaterialCustomization(
 		MaterialConfigs = NewConfigs;
 	}
 
+	if (FServerCosmeticsFilter::ShouldSkip(TEXT("CustomizationMaterials"), MaterialConfigs.Num()))
+	{
+		return;
+	}
+
 	// Material namespace data
 	TMap<FString, UCustomizationMaterialAsset*> MaterialNamespacesToData;
 	for (UCustomizationMaterialAsset* Config : MaterialConfigs)
@@ -0,0 +1,121 @@
+// Copyleft: All rights reversed
+
+
+#include "Customization/CustomizationPrefetchSubsystem.h"
+
+#include "Customization/CustomizationElementaryAsset.h"
+#include "Customization/CustomizationLoadoutInterface.h"
+#include "Customization/CustomizationMaterialAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "ServerCosmeticsFilter.h"
+
+
+void UCustomizationPrefetchSubsystem::Deinitialize()
+{
+	for (const TSharedPtr<FStreamableHandle>& Handle : LoadHandles)
+	{
+		Handle->ReleaseHandle();
+	}
+	LoadHandles.Empty();
+	RequestedPaths.Empty();
+
+	Super::Deinitialize();
+}
+
+
+bool UCustomizationPrefetchSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Dedicated servers only load the customization they need for collision, when pawns spawn
+	return !FServerCosmeticsFilter::IsActive() && Super::ShouldCreateSubsystem(Outer);
+}
+
+
+bool UCustomizationPrefetchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UCustomizationPrefetchSubsystem::PrefetchLoadout(
+	const TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+	const TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs)
+{
+	TArray<FSoftObjectPath> NewPaths;
+	auto AddIfNotRequested = [this, &NewPaths](const FSoftObjectPath& Path)
+	{
+		bool bAlreadyRequested = false;
+		if (!Path.IsNull())
+		{
+			RequestedPaths.Add(Path, &bAlreadyRequested);
+			if (!bAlreadyRequested)
+			{
+				NewPaths.Add(Path);
+			}
+		}
+	};
+
+	// Elementary assets reference their meshes, attachments and materials directly, so loading
+	// them streams the whole module in
+	for (const TSoftObjectPtr<UCustomizationElementaryAsset>& Asset : ElementaryAssets)
+	{
+		AddIfNotRequested(Asset.ToSoftObjectPath());
+	}
+
+	for (const TSoftObjectPtr<UCustomizationMaterialAsset>& Config : MaterialConfigs)
+	{
+		AddIfNotRequested(Config.ToSoftObjectPath());
+	}
+
+	if (!NewPaths.IsEmpty())
+	{
+		RequestAsyncLoad(MoveTemp(NewPaths));
+	}
+}
+
+
+bool UCustomizationPrefetchSubsystem::IsPrefetchComplete() const
+{
+	for (const TSharedPtr<FStreamableHandle>& Handle : LoadHandles)
+	{
+		if (Handle->IsLoadingInProgress())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void UCustomizationPrefetchSubsystem::PrefetchLoadoutOf(const UObject* LoadoutSource)
+{
+	if (!LoadoutSource || !LoadoutSource->Implements<UCustomizationLoadoutInterface>())
+	{
+		return;
+	}
+
+	TArray<TSoftObjectPtr<UCustomizationElementaryAsset>> ElementaryAssets;
+	TArray<TSoftObjectPtr<UCustomizationMaterialAsset>> MaterialConfigs;
+	ICustomizationLoadoutInterface::Execute_GetCustomizationLoadout(LoadoutSource, ElementaryAssets, MaterialConfigs);
+	PrefetchLoadout(ElementaryAssets, MaterialConfigs);
+}
+
+
+UCustomizationPrefetchSubsystem* UCustomizationPrefetchSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCustomizationPrefetchSubsystem>() : nullptr;
+}
+
+
+void UCustomizationPrefetchSubsystem::RequestAsyncLoad(TArray<FSoftObjectPath>&& Paths)
+{
+	UE_LOG(LogTemp, Verbose, TEXT("Prefetching %d customization assets"), Paths.Num());
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(Paths), FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+	if (Handle.IsValid())
+	{
+		LoadHandles.Add(Handle);
+	}
+}
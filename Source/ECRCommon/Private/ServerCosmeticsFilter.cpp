@@ -0,0 +1,253 @@
+// Copyleft: All rights reversed
+
+
+#include "ServerCosmeticsFilter.h"
+
+#include "Animation/AnimSequenceBase.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectHash.h"
+
+
+namespace ServerCosmetics
+{
+	static bool bStrip = true;
+	static FAutoConsoleVariableRef CVarStrip(
+		TEXT("ECR.ServerCosmetics.Strip"),
+		bStrip,
+		TEXT("Skip cosmetic-only notifies, components and customization steps on dedicated servers. "
+			"Read when worlds are created."),
+		ECVF_Default);
+
+	static const FName AnimNotifyEventsWorkName = TEXT("AnimNotifyEventsDisabled");
+	static const FName ComponentsWorkName = TEXT("Components");
+}
+
+
+bool FServerCosmeticsFilter::IsActive()
+{
+	return IsRunningDedicatedServer() && ServerCosmetics::bStrip;
+}
+
+
+TSet<const UClass*>& FServerCosmeticsFilter::GetCosmeticClasses()
+{
+	static TSet<const UClass*> CosmeticClasses;
+	return CosmeticClasses;
+}
+
+
+TMap<FName, int64>& FServerCosmeticsFilter::GetSkippedCounts()
+{
+	static TMap<FName, int64> SkippedCounts;
+	return SkippedCounts;
+}
+
+
+void FServerCosmeticsFilter::RegisterCosmeticClass(const UClass* Class)
+{
+	if (Class)
+	{
+		GetCosmeticClasses().Add(Class);
+	}
+}
+
+
+bool FServerCosmeticsFilter::IsCosmeticClass(const UClass* Class)
+{
+	const TSet<const UClass*>& CosmeticClasses = GetCosmeticClasses();
+	if (CosmeticClasses.IsEmpty())
+	{
+		return false;
+	}
+
+	for (const UClass* SuperClass = Class; SuperClass; SuperClass = SuperClass->GetSuperClass())
+	{
+		if (CosmeticClasses.Contains(SuperClass))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+bool FServerCosmeticsFilter::ShouldSkip(const FName WorkName, const int32 Amount)
+{
+	if (!IsActive())
+	{
+		return false;
+	}
+
+	RecordSkipped(WorkName, Amount);
+	return true;
+}
+
+
+void FServerCosmeticsFilter::RecordSkipped(const FName WorkName, const int32 Amount)
+{
+	// Counters aren't synchronized, cosmetic work we skip is all started on the game thread
+	if (Amount > 0 && IsInGameThread())
+	{
+		GetSkippedCounts().FindOrAdd(WorkName) += Amount;
+	}
+}
+
+
+void FServerCosmeticsFilter::ConsumeSkippedCounts(TMap<FName, int64>& OutCounts)
+{
+	OutCounts = MoveTemp(GetSkippedCounts());
+	GetSkippedCounts().Reset();
+}
+
+
+int32 FServerCosmeticsFilter::StripAnimNotifies(UAnimSequenceBase* Animation)
+{
+	if (!Animation)
+	{
+		return 0;
+	}
+
+	// Notify queue skips events not triggered on dedicated servers, so disabled ones never reach the notify objects
+	int32 StrippedAmount = 0;
+	for (FAnimNotifyEvent& NotifyEvent : Animation->Notifies)
+	{
+		if (!NotifyEvent.bTriggerOnDedicatedServer)
+		{
+			continue;
+		}
+
+		const UObject* NotifyObject = NotifyEvent.NotifyStateClass
+			                              ? static_cast<const UObject*>(NotifyEvent.NotifyStateClass)
+			                              : static_cast<const UObject*>(NotifyEvent.Notify);
+		if (NotifyObject && IsCosmeticClass(NotifyObject->GetClass()))
+		{
+			NotifyEvent.bTriggerOnDedicatedServer = false;
+			StrippedAmount++;
+		}
+	}
+
+	RecordSkipped(ServerCosmetics::AnimNotifyEventsWorkName, StrippedAmount);
+	return StrippedAmount;
+}
+
+
+int32 FServerCosmeticsFilter::StripComponents(AActor* Actor)
+{
+	if (!Actor || GetCosmeticClasses().IsEmpty())
+	{
+		return 0;
+	}
+
+	int32 StrippedAmount = 0;
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component->IsRegistered() && IsCosmeticClass(Component->GetClass()))
+		{
+			// Components can be referenced by gameplay code, so they are kept alive but do nothing
+			Component->Deactivate();
+			Component->SetAutoActivate(false);
+			Component->SetComponentTickEnabled(false);
+			Component->UnregisterComponent();
+			StrippedAmount++;
+		}
+	}
+
+	RecordSkipped(ServerCosmetics::ComponentsWorkName, StrippedAmount);
+	return StrippedAmount;
+}
+
+
+bool UServerCosmeticsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FServerCosmeticsFilter::IsActive() && Super::ShouldCreateSubsystem(Outer);
+}
+
+
+void UServerCosmeticsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (const FSoftClassPath& ClassPath : CosmeticClasses)
+	{
+		if (const UClass* Class = ClassPath.TryLoadClass<UObject>())
+		{
+			FServerCosmeticsFilter::RegisterCosmeticClass(Class);
+		}
+		else
+		{
+			// Classes of disabled plugins are expected to be missing
+			UE_LOG(LogTemp, Verbose, TEXT("Cosmetic class %s not found"), *ClassPath.ToString());
+		}
+	}
+
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &UServerCosmeticsSubsystem::HandleActorSpawned));
+
+	// FCoreUObjectDelegates::OnAssetLoaded is only broadcast in editor builds, so animations loaded later are rescanned
+	AnimationScanTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UServerCosmeticsSubsystem::HandleAnimationScanTicker),
+		FMath::Max(AnimationScanInterval, 1.f));
+}
+
+
+void UServerCosmeticsSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(AnimationScanTickerHandle);
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+
+	Super::Deinitialize();
+}
+
+
+void UServerCosmeticsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	StripLoadedAnimations();
+
+	// Actors placed in the map don't go through the spawn handler
+	int32 StrippedAmount = 0;
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		StrippedAmount += FServerCosmeticsFilter::StripComponents(*It);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Stripped %d cosmetic components of placed actors in %s"), StrippedAmount,
+	       *InWorld.GetName());
+}
+
+
+bool UServerCosmeticsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UServerCosmeticsSubsystem::StripLoadedAnimations()
+{
+	ForEachObjectOfClass(UAnimSequenceBase::StaticClass(), [](UObject* Object)
+	{
+		FServerCosmeticsFilter::StripAnimNotifies(CastChecked<UAnimSequenceBase>(Object));
+	});
+}
+
+
+void UServerCosmeticsSubsystem::HandleActorSpawned(AActor* Actor)
+{
+	FServerCosmeticsFilter::StripComponents(Actor);
+}
+
+
+bool UServerCosmeticsSubsystem::HandleAnimationScanTicker(float DeltaTime)
+{
+	// Already disabled events are skipped, so rescans only cost the iteration over animations
+	StripLoadedAnimations();
+	return true;
+}
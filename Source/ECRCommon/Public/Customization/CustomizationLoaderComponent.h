@@ -27,6 +27,11 @@ class ECRCOMMON_API UCustomizationLoaderComponent : public USceneComponent
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
 	bool bUseParentSkeleton;
 
+	/** Whether nothing on the server attaches to, traces against or reads sockets of the loaded meshes, so dedicated
+	 * servers skip loading them */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
+	bool bCosmeticOnly;
+
 	/** Collision profile name to use for static and skeletal components. Leave None for default */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
 	FName CollisionProfileName;
@@ -77,6 +82,7 @@ protected:
 	template <class ComponentClass>
 	static FName GetExistingSocketNameOrNameNone(const ComponentClass* Component, FName SocketName);
 
+public:
 	/** Load CustomizationLoaderAsset. Note that previous loaded meshes won't be destroyed,
 	 * you should call UnloadPreviousCustomization for that */
 	UFUNCTION(BlueprintCallable)
@@ -87,7 +93,6 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	void UnloadPreviousCustomization();
 
-public:
 	UCustomizationLoaderComponent();
 
 	/** LoadFromAsset on BeginPlay */
@@ -0,0 +1,32 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "CustomizationLoadoutInterface.generated.h"
+
+class UCustomizationElementaryAsset;
+class UCustomizationMaterialAsset;
+
+/** Interface for objects providing the customization loadout of a player */
+UINTERFACE(BlueprintType)
+class ECRCOMMON_API UCustomizationLoadoutInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by actors knowing the customization a player's pawn will be loaded with (player states),
+ * so UCustomizationPrefetchSubsystem can stream it in before the pawn spawns
+ */
+class ECRCOMMON_API ICustomizationLoadoutInterface
+{
+	GENERATED_BODY()
+
+public:
+	/** Get elementary assets and material configs the pawn of this player will pass to UCustomizationLoaderComponent */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
+	void GetCustomizationLoadout(TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+	                             TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs) const;
+};
@@ -0,0 +1,58 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CustomizationPrefetchSubsystem.generated.h"
+
+class UCustomizationElementaryAsset;
+class UCustomizationMaterialAsset;
+struct FStreamableHandle;
+
+/**
+ * Streams customization of connected players in asynchronously before their pawns spawn. Implementers of
+ * ICustomizationLoadoutInterface call PrefetchLoadoutOf when their loadout is set or replicates, so loadouts of
+ * players already in the match are requested while the map loads and ones of joining players as soon as their
+ * player state arrives. Loaded assets are kept in memory for the lifetime of the world.
+ */
+UCLASS(Config=Game)
+class ECRCOMMON_API UCustomizationPrefetchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Request async load of a loadout, already requested assets are skipped */
+	UFUNCTION(BlueprintCallable)
+	void PrefetchLoadout(const TArray<TSoftObjectPtr<UCustomizationElementaryAsset>>& ElementaryAssets,
+	                     const TArray<TSoftObjectPtr<UCustomizationMaterialAsset>>& MaterialConfigs);
+
+	/** Request async load of the loadout of an object implementing ICustomizationLoadoutInterface */
+	UFUNCTION(BlueprintCallable)
+	void PrefetchLoadoutOf(const UObject* LoadoutSource);
+
+	/** Get subsystem of the object's world, null where customization isn't prefetched (dedicated servers) */
+	static UCustomizationPrefetchSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Whether every requested asset is loaded */
+	UFUNCTION(BlueprintCallable, BlueprintPure)
+	bool IsPrefetchComplete() const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	void RequestAsyncLoad(TArray<FSoftObjectPath>&& Paths);
+
+private:
+	TSet<FSoftObjectPath> RequestedPaths;
+
+	TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+};
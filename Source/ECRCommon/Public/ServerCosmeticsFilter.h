@@ -0,0 +1,98 @@
+// Copyleft: All rights reversed
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ServerCosmeticsFilter.generated.h"
+
+class UAnimSequenceBase;
+
+/**
+ * FServerCosmeticsFilter
+ *
+ *	Registry of cosmetic-only classes and work skipped on dedicated servers. Events of registered notify classes
+ *	are disabled for dedicated servers in loaded animations, so they are never queued, and registered component
+ *	classes are deactivated and unregistered when their actor spawns. Code paths that are cosmetic only check
+ *	ShouldSkip with a work name. Everything skipped is counted per work name for server profiling, disabled notify
+ *	events are counted once when they are disabled rather than per skipped dispatch.
+ */
+class ECRCOMMON_API FServerCosmeticsFilter
+{
+public:
+	/** Whether cosmetic work is stripped in this process */
+	static bool IsActive();
+
+	/** Register notify or component class as cosmetic only, subclasses are included */
+	static void RegisterCosmeticClass(const UClass* Class);
+
+	static bool IsCosmeticClass(const UClass* Class);
+
+	/** Whether named cosmetic work should be skipped, counts the skip if it should */
+	static bool ShouldSkip(FName WorkName, int32 Amount = 1);
+
+	static void RecordSkipped(FName WorkName, int32 Amount = 1);
+
+	/** Move skipped work counts accumulated since the last call to OutCounts */
+	static void ConsumeSkippedCounts(TMap<FName, int64>& OutCounts);
+
+	/** Disable events of cosmetic notify classes for dedicated servers, returns amount of events disabled */
+	static int32 StripAnimNotifies(UAnimSequenceBase* Animation);
+
+	/** Deactivate and unregister cosmetic components of the actor, returns amount of components stripped */
+	static int32 StripComponents(AActor* Actor);
+
+private:
+	static TSet<const UClass*>& GetCosmeticClasses();
+	static TMap<FName, int64>& GetSkippedCounts();
+};
+
+/**
+ * UServerCosmeticsSubsystem
+ *
+ *	Applies FServerCosmeticsFilter to game worlds of dedicated servers. Cosmetic classes are registered from config,
+ *	so classes of plugins that can't depend on game modules can be registered too. Animations already loaded are
+ *	stripped on begin play, ones loaded later during the match by periodic rescans.
+ */
+UCLASS(Config=Game)
+class ECRCOMMON_API UServerCosmeticsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~End of UWorldSubsystem interface
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	/** Notify and component classes that only matter to players */
+	UPROPERTY(Config)
+	TArray<FSoftClassPath> CosmeticClasses;
+
+	/** Seconds between rescans of loaded animations for ones loaded during the match */
+	UPROPERTY(Config)
+	float AnimationScanInterval = 10.f;
+
+private:
+	void StripLoadedAnimations();
+
+	void HandleActorSpawned(AActor* Actor);
+
+	bool HandleAnimationScanTicker(float DeltaTime);
+
+private:
+	FDelegateHandle ActorSpawnedHandle;
+
+	FTSTicker::FDelegateHandle AnimationScanTickerHandle;
+};